@@ -0,0 +1,95 @@
+#include "claim_strategy.h"
+
+#include <iostream>
+#include "sys/time.h"
+
+using namespace disruptor;
+
+// Compare the available buffer layouts: memory per ring, single thread
+// publish throughput and the cost of a consumer catching up on a published
+// batch with the block scan of GetHighesetPublishedSequence versus checking
+// IsAvailable slot by slot
+static double Elapsed(const struct timeval& start_time,const struct timeval& end_time)
+{
+    double start = start_time.tv_sec + ((double) start_time.tv_usec / 1000000);
+    double end = end_time.tv_sec + ((double) end_time.tv_usec / 1000000);
+    return end - start;
+}
+
+static void RunLayout(const char* name,AvailableBufferOption available_option)
+{
+    const int64_t ring_buffer_size = 1024 * 64;
+    const int64_t batch_size = 4096;
+    Sequence cursor;
+    std::vector<Sequence*> gating_sequences;
+    MultiThreadStrategy strategy(ring_buffer_size,cursor,available_option);
+    ClaimStrategy* claim_strategy = &strategy;
+
+    struct timeval start_time;
+    struct timeval end_time;
+
+    // publish one sequence at a time
+    int64_t publish_iterations = 50000000;
+    gettimeofday(&start_time,NULL);
+    for(int64_t i = 0; i < publish_iterations; ++i) {
+        claim_strategy->Publish(claim_strategy->IncrementAndGet(gating_sequences,1));
+    }
+    gettimeofday(&end_time,NULL);
+    const double publish_seconds = Elapsed(start_time,end_time);
+
+    // finish the round, then publish a batch crossing the ring wrap
+    int64_t fill_size = ring_buffer_size - (cursor.GetSequence() + 1L) % ring_buffer_size - batch_size / 2;
+    if(fill_size <= 0) {
+        fill_size += ring_buffer_size;
+    }
+    const int64_t round_end = claim_strategy->IncrementAndGet(gating_sequences,fill_size);
+    claim_strategy->Publish(round_end - fill_size + 1L,round_end);
+    const int64_t low_bound = round_end + 1L;
+    const int64_t high_bound = claim_strategy->IncrementAndGet(gating_sequences,batch_size);
+    claim_strategy->Publish(low_bound,high_bound);
+
+    int64_t scan_iterations = 200000;
+    int64_t checksum = 0;
+    gettimeofday(&start_time,NULL);
+    for(int64_t i = 0; i < scan_iterations; ++i) {
+        checksum += claim_strategy->GetHighesetPublishedSequence(low_bound,high_bound);
+    }
+    gettimeofday(&end_time,NULL);
+    const double scan_seconds = Elapsed(start_time,end_time);
+
+    gettimeofday(&start_time,NULL);
+    for(int64_t i = 0; i < scan_iterations; ++i) {
+        int64_t sequence = low_bound;
+        while(sequence <= high_bound && claim_strategy->IsAvailable(sequence)) {
+            ++sequence;
+        }
+        checksum -= sequence - 1L;
+    }
+    gettimeofday(&end_time,NULL);
+    const double scalar_seconds = Elapsed(start_time,end_time);
+
+    const double memory_per_slot = strategy.GetAvailableBuffer().MemorySize() * 1.0 / ring_buffer_size;
+    std::cout << name << " available buffer: " << std::endl;
+    std::cout << "  Memory for 64M slots/MB: "
+              << memory_per_slot * 1024 * 1024 * 64 / (1024 * 1024)
+              << std::endl;
+    std::cout << "  Publish Ops/secs: "
+              << (publish_iterations * 1.0) / publish_seconds
+              << std::endl;
+    std::cout << "  Block scan(batch " << batch_size << ") Latency/ns: "
+              << scan_seconds * 1000000000.0 / scan_iterations
+              << std::endl;
+    std::cout << "  Slot by slot(batch " << batch_size << ") Latency/ns: "
+              << scalar_seconds * 1000000000.0 / scan_iterations
+              << std::endl;
+    std::cout << "  Checksum: " << checksum << std::endl;
+}
+
+int main(int argc,char** argv)
+{
+    std::cout.precision(12);
+    RunLayout("Wide",kWideAvailableBuffer);
+    RunLayout("Compact",kCompactAvailableBuffer);
+    RunLayout("Bitmap",kBitmapAvailableBuffer);
+    return 0;
+}
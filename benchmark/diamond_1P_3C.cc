@@ -9,23 +9,25 @@
 
 using namespace disruptor;
 
+// strategies are static policies, no virtual dispatch on the hot path
+using StubSequencer = Sequencer<test::StubEvent,SingleThreadStrategy,BusySpinStrategy>;
+
 int main(int argc,char** argv)
 {
     const int64_t ring_buffer_size = 1024 * 1024 * 64;
-    Sequencer<test::StubEvent>* sequencer = new Sequencer<test::StubEvent>(ring_buffer_size,
-                kSingleThreadClaimStrategy,kBusySpinStrategy);
+    StubSequencer* sequencer = new StubSequencer(ring_buffer_size);
     
     // get processor barrier with dependents
     std::vector<Sequence*> dependents;
-    SequenceBarrier* first_barrier = sequencer->NewBarrier(dependents);
+    StubSequencer::Barrier* first_barrier = sequencer->NewBarrier(dependents);
 
     // first and second processor without dependents
     test::StubEventHandler event_handler;
-    EventProcessor<test::StubEvent> first_event_processor(sequencer,first_barrier,&event_handler);
+    EventProcessor<test::StubEvent,StubSequencer> first_event_processor(sequencer,first_barrier,&event_handler);
     std::thread first_consumer([&first_event_processor](){
         first_event_processor.Run();
     });
-    EventProcessor<test::StubEvent> second_event_processor(sequencer,first_barrier,&event_handler);
+    EventProcessor<test::StubEvent,StubSequencer> second_event_processor(sequencer,first_barrier,&event_handler);
     std::thread second_consumer([&second_event_processor](){
         second_event_processor.Run();
     });
@@ -34,8 +36,8 @@ int main(int argc,char** argv)
     dependents.clear();
     dependents.push_back(first_event_processor.GetSequence());
     dependents.push_back(second_event_processor.GetSequence());
-    SequenceBarrier* second_barrier = sequencer->NewBarrier(dependents);
-    EventProcessor<test::StubEvent> third_event_processor(sequencer,second_barrier,&event_handler);
+    StubSequencer::Barrier* second_barrier = sequencer->NewBarrier(dependents);
+    EventProcessor<test::StubEvent,StubSequencer> third_event_processor(sequencer,second_barrier,&event_handler);
     std::thread third_consumer([&third_event_processor](){
         third_event_processor.Run();
     });
@@ -51,7 +53,7 @@ int main(int argc,char** argv)
     gettimeofday(&start_time,NULL);
 
     test::StubEventTranslator event_translator;
-    EventProducer<test::StubEvent> event_producer(sequencer);
+    EventProducer<test::StubEvent,StubSequencer> event_producer(sequencer);
     int64_t iterations = 500000000;
     int64_t batch_size = 1;
     for(int64_t i = 0; i < iterations; ++i) {
@@ -0,0 +1,77 @@
+#include "sequence.h"
+#include "clock.h"
+
+#include <iostream>
+#include <thread>
+
+using namespace disruptor;
+
+// A producer publishing a sequence while a consumer reads the member next
+// to it, e.g. Sequencer::_cursor followed by the pointers the consumers
+// read. With the padding only before the atomic the neighbour shares its
+// cache line and every publish invalidates the consumer's copy
+struct OneSidedLayout
+{
+    int64_t padding[ATOMIC_SEQUENCE_PADDING_LENGTH];
+    std::atomic<int64_t> sequence;
+    int64_t neighbour;
+};
+
+struct TwoSidedLayout
+{
+    Sequence sequence;
+    int64_t neighbour;
+};
+
+static void SetSequence(OneSidedLayout* layout,int64_t value)
+{
+    layout->sequence.store(value,std::memory_order::memory_order_release);
+}
+
+static void SetSequence(TwoSidedLayout* layout,int64_t value)
+{
+    layout->sequence.SetSequence(value);
+}
+
+template<typename L>
+static void RunLayout(const char* name,int64_t iterations)
+{
+    L* layout = new L();
+    layout->neighbour = 1;
+    std::atomic<bool> done(false);
+    int64_t reads = 0;
+    int64_t checksum = 0;
+    std::thread reader([&](){
+        while(!done.load(std::memory_order::memory_order_relaxed)) {
+            for(int i = 0; i < 64; ++i) {
+                checksum += *static_cast<volatile int64_t*>(&layout->neighbour);
+            }
+            reads += 64;
+        }
+    });
+
+    const int64_t start = SteadyClock::NowNanos();
+    for(int64_t i = 0; i < iterations; ++i) {
+        SetSequence(layout,i);
+    }
+    const int64_t end = SteadyClock::NowNanos();
+    done.store(true);
+    reader.join();
+
+    std::cout << name << " layout: " << std::endl;
+    std::cout << "  Publish Latency/ns: "
+              << (end - start) * 1.0 / iterations << std::endl;
+    std::cout << "  Neighbour reads/secs: "
+              << reads * 1000000000.0 / (end - start) << std::endl;
+    std::cout << "  Checksum: " << checksum - reads << std::endl;
+    delete layout;
+}
+
+int main(int argc,char** argv)
+{
+    const int64_t iterations = 100000000L;
+    std::cout.precision(12);
+    RunLayout<OneSidedLayout>("One sided padding",iterations);
+    RunLayout<TwoSidedLayout>("Two sided padding",iterations);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "fixed_ring_buffer.h"
+#include "clock.h"
+
+#include <iostream>
+
+using namespace disruptor;
+
+// Cost of writing a batch of slots through operator[] of a small ring
+// sized at runtime versus at compile time, whose constant mask and inline
+// storage let the compiler unroll the batch loop
+template<typename R>
+static void RunRing(const char* name,R& ring_buffer,int64_t iterations)
+{
+    const int64_t batch_size = 16;
+    const int64_t start = SteadyClock::NowNanos();
+    for(int64_t sequence = 0; sequence < iterations; sequence += batch_size) {
+        for(int64_t i = sequence; i < sequence + batch_size; ++i) {
+            *ring_buffer[i] = i;
+        }
+    }
+    const int64_t end = SteadyClock::NowNanos();
+    int64_t checksum = 0;
+    for(int64_t i = 0; i < ring_buffer.GetSize(); ++i) {
+        checksum += *ring_buffer[i];
+    }
+    std::cout << name << " write Latency/ns: "
+              << (end - start) * 1.0 / iterations
+              << " (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc,char** argv)
+{
+    const int64_t iterations = 1000L * 1000L * 500;
+    std::cout.precision(4);
+    RingBuffer<int64_t> ring_buffer(256);
+    RunRing("RingBuffer(256)",ring_buffer,iterations);
+    FixedRingBuffer<int64_t,256> fixed_ring_buffer;
+    RunRing("FixedRingBuffer<256>",fixed_ring_buffer,iterations);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "event/event_producer.h"
+#include "event/event_processor.h"
+#include "support/stub_event.h"
+#include "clock.h"
+
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace disruptor;
+
+// Multicast 1P-NC throughput with the producer gated on every consumer
+// sequence versus on the root of a GatingTree, the producer's wrap check
+// reads N cache lines in the first case and one in the second
+static void RunMulticast(size_t consumer_count,bool use_gating_tree)
+{
+    const int64_t iterations = 1000L * 1000L * 2;
+    Sequencer<test::StubEvent> sequencer(1024 * 8,kSingleThreadClaimStrategy,kYieldingStrategy);
+    std::vector<Sequence*> dependents;
+    SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+
+    test::StubEventHandler event_handler;
+    std::vector<std::unique_ptr<EventProcessor<test::StubEvent>>> event_processors;
+    std::vector<Sequence*> sequences;
+    for(size_t i = 0; i < consumer_count; ++i) {
+        event_processors.emplace_back(new EventProcessor<test::StubEvent>(&sequencer,barrier,&event_handler));
+        sequences.push_back(event_processors.back()->GetSequence());
+    }
+    GatingTree gating_tree(sequences);
+    if(use_gating_tree) {
+        sequencer.SetGatingSequences(std::vector<Sequence*>({gating_tree.GetRoot()}));
+        for(size_t i = 0; i < consumer_count; ++i) {
+            event_processors[i]->SetGatingTree(&gating_tree,i);
+        }
+    }
+    else {
+        sequencer.SetGatingSequences(sequences);
+    }
+
+    std::vector<std::thread> consumers;
+    for(auto& event_processor : event_processors) {
+        EventProcessor<test::StubEvent>* processor = event_processor.get();
+        consumers.emplace_back([processor](){
+            processor->Run();
+        });
+    }
+
+    test::StubEventTranslator event_translator;
+    EventProducer<test::StubEvent> event_producer(&sequencer);
+    const int64_t start = SteadyClock::NowNanos();
+    for(int64_t i = 0; i < iterations; ++i) {
+        event_producer.PublishEvent(&event_translator,1);
+    }
+    while(GetMinimumSequence(sequences) < iterations - 1) {
+        std::this_thread::yield();
+    }
+    const int64_t end = SteadyClock::NowNanos();
+
+    for(auto& event_processor : event_processors) {
+        event_processor->Stop();
+    }
+    for(auto& consumer : consumers) {
+        consumer.join();
+    }
+    std::cout << "1P-" << consumer_count << "C "
+              << (use_gating_tree ? "gating tree" : "flat gating")
+              << " Ops/secs: "
+              << iterations * 1000000000.0 / (end - start)
+              << std::endl;
+}
+
+int main(int argc,char** argv)
+{
+    std::cout.precision(12);
+    for(size_t consumer_count : {4,16,64}) {
+        RunMulticast(consumer_count,false);
+        RunMulticast(consumer_count,true);
+    }
+    return 0;
+}
\ No newline at end of file
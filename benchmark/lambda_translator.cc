@@ -0,0 +1,45 @@
+#include "sequencer.h"
+#include "event/event_producer.h"
+#include "support/stub_event.h"
+#include "clock.h"
+
+#include <iostream>
+
+using namespace disruptor;
+
+using StubSequencer = Sequencer<test::StubEvent,SingleThreadStrategy,BusySpinStrategy>;
+
+// Producer side cost of publishing through the virtual EventTranslator
+// versus a lambda inlined into the claim and publish. No consumer gates the
+// producer so only the claim, translate and publish path is measured
+template<typename P>
+static void RunProducer(const char* name,P publish,int64_t iterations)
+{
+    StubSequencer sequencer(1024 * 64);
+    EventProducer<test::StubEvent,StubSequencer> event_producer(&sequencer);
+    const int64_t start = SteadyClock::NowNanos();
+    for(int64_t i = 0; i < iterations; ++i) {
+        publish(event_producer,i);
+    }
+    const int64_t end = SteadyClock::NowNanos();
+    std::cout << name << " publish Latency/ns: "
+              << (end - start) * 1.0 / iterations
+              << " (cursor " << sequencer.GetCursor() << ")" << std::endl;
+}
+
+int main(int argc,char** argv)
+{
+    const int64_t iterations = 1000L * 1000L * 200;
+    std::cout.precision(4);
+    test::StubEventTranslator event_translator;
+    EventTranslator<test::StubEvent>* translator = &event_translator;
+    RunProducer("Virtual translator",[translator](EventProducer<test::StubEvent,StubSequencer>& producer,int64_t){
+        producer.PublishEvent(translator,1);
+    },iterations);
+    RunProducer("Lambda translator",[](EventProducer<test::StubEvent,StubSequencer>& producer,int64_t value){
+        producer.PublishEvent([](const int64_t& sequence,test::StubEvent* event,int64_t value){
+            event->SetValue(value);
+        },value);
+    },iterations);
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "ring_buffer.h"
+#include "clock.h"
+
+#include <iostream>
+
+using namespace disruptor;
+
+// trivially default constructible, so it can be lazily initialized
+struct TickEvent
+{
+    int64_t price;
+    int64_t quantity;
+};
+
+// Time to build a large ring with each slot init option and time of the
+// first and second lap writing every slot: a lazily built ring pays its
+// page faults during the first lap
+static void RunInit(const char* name,const SlotInitPolicy<TickEvent>& slot_init,
+                    const MemoryPolicy& memory_policy)
+{
+    const int64_t ring_buffer_size = 1024 * 1024 * 16;
+    const int64_t start = SteadyClock::NowNanos();
+    RingBuffer<TickEvent> ring_buffer(ring_buffer_size,kPackedSlotLayout,
+                                            kDefaultSlotsPerGroup,memory_policy,slot_init);
+    const int64_t built = SteadyClock::NowNanos();
+    for(int64_t i = 0; i < ring_buffer_size; ++i) {
+        ring_buffer[i]->price = i;
+    }
+    const int64_t first_lap = SteadyClock::NowNanos();
+    for(int64_t i = ring_buffer_size; i < 2 * ring_buffer_size; ++i) {
+        ring_buffer[i]->price = i;
+    }
+    const int64_t second_lap = SteadyClock::NowNanos();
+
+    std::cout << name << " init: " << std::endl;
+    std::cout << "  Build/ms: " << (built - start) / 1000000.0 << std::endl;
+    std::cout << "  First lap/ms: " << (first_lap - built) / 1000000.0 << std::endl;
+    std::cout << "  Second lap/ms: " << (second_lap - first_lap) / 1000000.0 << std::endl;
+}
+
+int main(int argc,char** argv)
+{
+    std::cout.precision(6);
+    const MemoryPolicy mapped(kTransparentHugePages);
+    RunInit("Serial",SlotInitPolicy<TickEvent>(kSerialSlotInit),mapped);
+    RunInit("Parallel",SlotInitPolicy<TickEvent>(kParallelSlotInit),mapped);
+    RunInit("Lazy",SlotInitPolicy<TickEvent>(kLazySlotInit),mapped);
+    return 0;
+}
\ No newline at end of file
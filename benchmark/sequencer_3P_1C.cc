@@ -13,9 +13,11 @@ using namespace disruptor;
 int main(int argc,char** argv)
 {
     // construct sequencer
+    // producers claim with fetch_add, use kMultiThreadClaimStrategy
+    // to compare with the compare and set claim
     const int64_t ring_buffer_size = 1024 * 1024 * 64;
     Sequencer<test::StubEvent>* sequencer = new Sequencer<test::StubEvent>(ring_buffer_size,
-                    kMultiThreadClaimStrategy,kBusySpinStrategy);
+                    kMultiThreadFetchAddClaimStrategy,kBusySpinStrategy);
     
     // get processor without dependents
     std::vector<Sequence*> dependents;
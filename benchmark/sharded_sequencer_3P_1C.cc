@@ -0,0 +1,92 @@
+#include "sharded_sequencer.h"
+#include "event/event_producer.h"
+#include "event/sharded_event_processor.h"
+#include "support/stub_event.h"
+
+#include <iostream>
+#include <thread>
+#include "sys/time.h"
+
+using namespace disruptor;
+
+using StubShardedSequencer = ShardedSequencer<test::StubEvent>;
+
+int main(int argc,char** argv)
+{
+    // construct sharded sequencer, one single writer ring per producer
+    const int64_t shard_buffer_size = 1024 * 1024 * 16;
+    StubShardedSequencer* sequencer = new StubShardedSequencer(shard_buffer_size);
+    StubShardedSequencer::Shard* first_shard = sequencer->AddProducer();
+    StubShardedSequencer::Shard* second_shard = sequencer->AddProducer();
+    StubShardedSequencer::Shard* third_shard = sequencer->AddProducer();
+
+    // construct event processor merging the shards
+    test::StubEventHandler event_handler;
+    ShardedEventProcessor<test::StubEvent> event_processor(sequencer,&event_handler);
+    std::thread consumer([&event_processor](){
+        event_processor.Run();
+    });
+
+    // construct event translator
+    struct timeval start_time;
+    struct timeval end_time;
+    gettimeofday(&start_time,NULL);
+
+    test::StubEventTranslator event_translator;
+    int64_t iterations = 500000000;
+    int64_t batch_size = 1;
+
+    // first event producer
+    EventProducer<test::StubEvent,StubShardedSequencer::Shard> first_event_producer(first_shard);
+    std::thread first_publisher([&](){
+        for(int64_t i = 0; i < iterations; ++i) {
+            first_event_producer.PublishEvent(&event_translator,batch_size);
+        }
+    });
+
+    // second event producer
+    EventProducer<test::StubEvent,StubShardedSequencer::Shard> second_event_producer(second_shard);
+    std::thread second_publisher([&](){
+        for(int64_t i = 0; i < iterations; ++i) {
+            second_event_producer.PublishEvent(&event_translator,batch_size);
+        }
+    });
+
+    // third event producer
+    EventProducer<test::StubEvent,StubShardedSequencer::Shard> third_event_producer(third_shard);
+    std::thread third_publisher([&](){
+        for(int64_t i = 0; i < iterations; ++i) {
+            third_event_producer.PublishEvent(&event_translator,batch_size);
+        }
+    });
+
+    for(size_t shard = 0; shard < sequencer->GetShardCount(); ++shard) {
+        while(event_processor.GetSequence(shard)->GetSequence() < iterations - 1) {
+            // wait
+        }
+    }
+    gettimeofday(&end_time,NULL);
+
+    double start = start_time.tv_sec + ((double) start_time.tv_usec / 1000000);
+    double end = end_time.tv_sec + ((double) end_time.tv_usec / 1000000);
+
+    // per producer, the same figures as sequencer_3P-1C
+    std::cout.precision(12);
+    std::cout << "Sharded sequencer 3P-1C performance: " << std::endl;
+    std::cout << "  Ops/secs: " 
+              << (iterations * 1.0) / (end - start)
+              << std::endl;
+    std::cout << "  Mb/secs: " 
+              << iterations * 64.0 / ((end - start) * 1000000)
+              << std::endl; 
+    std::cout << "  Latency/ns: "
+              << (end - start) * 1000000000.0 / iterations
+              << std::endl;
+
+    event_processor.Stop();
+    consumer.join();
+    first_publisher.join();
+    second_publisher.join();
+    third_publisher.join();
+    return 0; 
+}
@@ -0,0 +1,89 @@
+#include "sequencer.h"
+#include "event/event_producer.h"
+#include "event/event_processor.h"
+#include "clock.h"
+
+#include <iostream>
+#include <thread>
+
+using namespace disruptor;
+
+// Unicast 1P-1C throughput and memory of each slot layout with a 16 bytes
+// tick event, at a low queue depth the consumer reads the slot next to
+// the one the producer writes
+struct TickEvent
+{
+    int64_t price = 0;
+    int64_t quantity = 0;
+};
+
+class TickEventTranslator : public EventTranslator<TickEvent>
+{
+public:
+    virtual TickEvent* TranslateTo(const int64_t& sequence,TickEvent* event) override {
+        event->price = sequence;
+        event->quantity = sequence & 0xFF;
+        return event;
+    }
+};
+
+class TickEventHandler : public EventHandler<TickEvent>
+{
+public:
+    virtual void OnEvent(const int64_t& sequence,TickEvent* event) override {
+        checksum += event->price + event->quantity;
+    }
+    virtual void OnStart() override {}
+    virtual void OnShutdown() override {}
+
+    int64_t checksum = 0;
+};
+
+using TickSequencer = Sequencer<TickEvent,SingleThreadStrategy,YieldingStrategy>;
+
+static void RunLayout(const char* name,SlotLayoutOption layout,int64_t slots_per_group)
+{
+    const int64_t ring_buffer_size = 64;
+    const int64_t iterations = 1000L * 1000L * 20;
+    TickSequencer sequencer(ring_buffer_size,kSingleThreadClaimStrategy,kYieldingStrategy,
+                            kWideAvailableBuffer,kYieldingProducerWait,layout,slots_per_group);
+    std::vector<Sequence*> dependents;
+    TickSequencer::Barrier* barrier = sequencer.NewBarrier(dependents);
+    TickEventHandler event_handler;
+    EventProcessor<TickEvent,TickSequencer> event_processor(&sequencer,barrier,&event_handler);
+    sequencer.SetGatingSequences(std::vector<Sequence*>({event_processor.GetSequence()}));
+    std::thread consumer([&event_processor](){
+        event_processor.Run();
+    });
+
+    TickEventTranslator event_translator;
+    EventProducer<TickEvent,TickSequencer> event_producer(&sequencer);
+    const int64_t start = SteadyClock::NowNanos();
+    for(int64_t i = 0; i < iterations; ++i) {
+        event_producer.PublishEvent(&event_translator,1);
+    }
+    while(event_processor.GetSequence()->GetSequence() < iterations - 1) {
+        // wait
+    }
+    const int64_t end = SteadyClock::NowNanos();
+    event_processor.Stop();
+    consumer.join();
+
+    RingBuffer<TickEvent> ring_buffer(ring_buffer_size,layout,slots_per_group);
+    std::cout << name << " slot layout: " << std::endl;
+    std::cout << "  Bytes per slot: "
+              << ring_buffer.MemorySize() * 1.0 / ring_buffer_size << std::endl;
+    std::cout << "  Ops/secs: "
+              << iterations * 1000000000.0 / (end - start) << std::endl;
+    std::cout << "  Checksum: " << event_handler.checksum << std::endl;
+}
+
+int main(int argc,char** argv)
+{
+    std::cout.precision(12);
+    RunLayout("Packed",kPackedSlotLayout,1);
+    RunLayout("Padded",kPaddedSlotLayout,1);
+    RunLayout("Grouped(2 per range)",kGroupedSlotLayout,2);
+    RunLayout("Grouped(4 per range)",kGroupedSlotLayout,4);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "sequencer.h"
+#include "event/event_producer.h"
+#include "event/event_processor.h"
+#include "support/stub_event.h"
+#include "clock.h"
+
+#include <iostream>
+#include <thread>
+
+using namespace disruptor;
+
+using StubSequencer = Sequencer<test::StubEvent,SingleThreadStrategy,YieldingStrategy>;
+
+// Consumer side cost of a cheap counting handler called through the
+// virtual EventHandler versus a templated handler inlined into the
+// processor's batch loop. The ring is filled before the processor starts,
+// so the processor drains it in one batch
+class VirtualCountingHandler : public EventHandler<test::StubEvent>
+{
+public:
+    VirtualCountingHandler() : count(0) {}
+    virtual void OnEvent(const int64_t& sequence,test::StubEvent* event) override {
+        count += event->GetValue() & 1;
+    }
+    virtual void OnStart() override {}
+    virtual void OnShutdown() override {}
+
+    int64_t count;
+};
+
+class StaticCountingHandler final
+{
+public:
+    StaticCountingHandler() : count(0) {}
+    inline void OnEvent(const int64_t& sequence,test::StubEvent* event) {
+        count += event->GetValue() & 1;
+    }
+    void OnStart() {}
+    void OnShutdown() {}
+
+    int64_t count;
+};
+
+template<typename H,typename B>
+static void RunHandler(const char* name,H* event_handler,B* handler_base)
+{
+    const int64_t ring_buffer_size = 1024 * 1024 * 16;
+    StubSequencer sequencer(ring_buffer_size);
+    std::vector<Sequence*> dependents;
+    StubSequencer::Barrier* barrier = sequencer.NewBarrier(dependents);
+    EventProducer<test::StubEvent,StubSequencer> event_producer(&sequencer);
+    for(int64_t i = 0; i < ring_buffer_size; ++i) {
+        event_producer.PublishEvent([](const int64_t& sequence,test::StubEvent* event){
+            event->SetValue(sequence);
+        });
+    }
+
+    EventProcessor<test::StubEvent,StubSequencer,B> event_processor(&sequencer,barrier,handler_base);
+    const int64_t start = SteadyClock::NowNanos();
+    std::thread consumer([&event_processor](){
+        event_processor.Run();
+    });
+    while(event_processor.GetSequence()->GetSequence() < ring_buffer_size - 1) {
+        std::this_thread::yield();
+    }
+    const int64_t end = SteadyClock::NowNanos();
+    event_processor.Stop();
+    consumer.join();
+    std::cout << name << " OnEvent Latency/ns: "
+              << (end - start) * 1.0 / ring_buffer_size
+              << " (count " << event_handler->count << ")" << std::endl;
+}
+
+int main(int argc,char** argv)
+{
+    std::cout.precision(4);
+    VirtualCountingHandler virtual_handler;
+    RunHandler("Virtual handler",&virtual_handler,static_cast<EventHandler<test::StubEvent>*>(&virtual_handler));
+    StaticCountingHandler static_handler;
+    RunHandler("Templated handler",&static_handler,&static_handler);
+    return 0;
+}
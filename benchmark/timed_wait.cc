@@ -0,0 +1,45 @@
+#include "clock.h"
+
+#include <iostream>
+
+using namespace disruptor;
+
+// Cost per loop iteration of checking the deadline of a timed wait:
+// reading a clock on every iteration versus Deadline::Expired() which
+// reads WaitClock every kDefaultDeadlineCheckInterval iterations
+template<typename Clock>
+static void RunClock(const char* name,int64_t iterations)
+{
+    const int64_t start = SteadyClock::NowNanos();
+    int64_t checksum = 0;
+    for(int64_t i = 0; i < iterations; ++i) {
+        checksum += Clock::NowNanos() & 1;
+    }
+    const int64_t end = SteadyClock::NowNanos();
+    std::cout << name << " read Latency/ns: "
+              << (end - start) * 1.0 / iterations
+              << " (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc,char** argv)
+{
+    const int64_t iterations = 20000000L;
+    std::cout.precision(4);
+    RunClock<SteadyClock>("SteadyClock",iterations);
+#if defined(__x86_64__) || defined(__i386__)
+    RunClock<TscClock>("TscClock",iterations);
+#endif
+
+    Deadline deadline(std::chrono::hours(1));
+    const int64_t start = SteadyClock::NowNanos();
+    int64_t expired = 0;
+    for(int64_t i = 0; i < iterations; ++i) {
+        expired += deadline.Expired();
+    }
+    const int64_t end = SteadyClock::NowNanos();
+    std::cout << "Deadline::Expired(every " << kDefaultDeadlineCheckInterval
+              << " iterations) Latency/ns: "
+              << (end - start) * 1.0 / iterations
+              << " (expired " << expired << ")" << std::endl;
+    return 0;
+}
@@ -9,20 +9,22 @@
 
 using namespace disruptor;
 
+// strategies are static policies, no virtual dispatch on the hot path
+using StubSequencer = Sequencer<test::StubEvent,SingleThreadStrategy,BusySpinStrategy>;
+
 int main(int argc,char** argv) 
 {
     // construct sequencer
     const int64_t ring_buffer_size = 1024 * 1024 * 64;
-    Sequencer<test::StubEvent>* sequencer = new Sequencer<test::StubEvent>(ring_buffer_size,
-                    kSingleThreadClaimStrategy,kBusySpinStrategy);
+    StubSequencer* sequencer = new StubSequencer(ring_buffer_size);
 
     // get processor barrier without dependents
     std::vector<Sequence*> dependents;
-    SequenceBarrier* barrier = sequencer->NewBarrier(dependents);
+    StubSequencer::Barrier* barrier = sequencer->NewBarrier(dependents);
 
     // construct event processor with event_handler and above
     test::StubEventHandler event_handler;
-    EventProcessor<test::StubEvent> event_processor(sequencer,barrier,&event_handler);
+    EventProcessor<test::StubEvent,StubSequencer> event_processor(sequencer,barrier,&event_handler);
     std::thread consumer([&event_processor](){
         event_processor.Run();
     });
@@ -41,7 +43,7 @@ int main(int argc,char** argv)
     gettimeofday(&start_time,NULL);
 
     test::StubEventTranslator event_translator;
-    EventProducer<test::StubEvent> event_producer(sequencer);
+    EventProducer<test::StubEvent,StubSequencer> event_producer(sequencer);
     int64_t iterations = 500000000;
     int64_t batch_size = 1;
     test::StubEvent event;
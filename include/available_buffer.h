@@ -0,0 +1,257 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_AVAILABLE_BUFFER_H_
+#define DISRUPTOR_AVAILABLE_BUFFER_H_
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include "available_scan.h"
+#include "memory_policy.h"
+#include "utils.h"
+
+namespace disruptor {
+
+// Layout of the flags used by multi publisher strategies to track which
+// sequences are published
+//
+// A slot can only hold the round(wrap) number of the current sequence or of
+// the previous one: a publisher can not claim a slot again before every
+// consumer read it. So the round number does not need 64 bits to tell the
+// two apart, a truncated round or even its parity is enough.
+enum AvailableBufferOption
+{
+    // One int64_t round number per slot, 8 bytes per slot
+    kWideAvailableBuffer,
+    // One uint32_t truncated round number per slot, 4 bytes per slot
+    kCompactAvailableBuffer,
+    // One bit per slot holding the parity of the round, 1/8 byte per slot.
+    // A batch published by one publisher flips all of its bits of a
+    // 64 slots word with a single atomic operation
+    kBitmapAvailableBuffer
+};
+
+/**
+ * @brief Tracks the published sequences of a ring buffer
+ * Flags are written with relaxed stores, the callers fence the event
+ * writes before SetAvailable and the event reads after GetHighestAvailable
+*/
+class AvailableBuffer
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(AvailableBuffer);
+public:
+    explicit AvailableBuffer(int64_t buffer_size,
+                             AvailableBufferOption option = kWideAvailableBuffer,
+                             const MemoryPolicy& memory_policy = MemoryPolicy())
+        : _option(option),
+          _buffer_size(buffer_size),
+          _index_mask(buffer_size - 1),
+          _index_shift(util::Log2(buffer_size)),
+          _memory(new MemoryRegion(MemorySize(),memory_policy)),
+          _wide_flags(nullptr),
+          _compact_flags(nullptr),
+          _bitmap_words(nullptr) {
+        switch (_option) {
+        case kCompactAvailableBuffer:
+            _compact_flags = static_cast<uint32_t*>(_memory->GetAddress());
+            std::fill(_compact_flags,_compact_flags + buffer_size,static_cast<uint32_t>(-1));
+            break;
+        case kBitmapAvailableBuffer:
+            // All bits set: the parity of round -1
+            _bitmap_words = static_cast<std::atomic<uint64_t>*>(_memory->GetAddress());
+            for(int64_t i = 0; i < BitmapWordCount(); ++i) {
+                new (&_bitmap_words[i]) std::atomic<uint64_t>(~0ULL);
+            }
+            break;
+        case kWideAvailableBuffer:
+        default:
+            _wide_flags = static_cast<int64_t*>(_memory->GetAddress());
+            std::fill(_wide_flags,_wide_flags + buffer_size,-1L);
+            break;
+        }
+    }
+
+    // How the flags were allocated
+    const MemoryRegion& GetMemoryRegion() const {
+        return *_memory;
+    }
+
+    AvailableBufferOption GetOption() const {
+        return _option;
+    }
+
+    // Bytes used by the flags
+    size_t MemorySize() const {
+        switch (_option) {
+        case kCompactAvailableBuffer:
+            return _buffer_size * sizeof(uint32_t);
+        case kBitmapAvailableBuffer:
+            return BitmapWordCount() * sizeof(uint64_t);
+        case kWideAvailableBuffer:
+        default:
+            return _buffer_size * sizeof(int64_t);
+        }
+    }
+
+    void SetAvailable(int64_t sequence) {
+        const int64_t index = CalculateIndex(sequence);
+        switch (_option) {
+        case kCompactAvailableBuffer:
+            _compact_flags[index] = static_cast<uint32_t>(CalculateRound(sequence));
+            break;
+        case kBitmapAvailableBuffer:
+            // the slot holds the parity of the previous round, flip it
+            _bitmap_words[index >> 6].fetch_xor(1ULL << (index & 63),
+                                                std::memory_order::memory_order_relaxed);
+            break;
+        case kWideAvailableBuffer:
+        default:
+            _wide_flags[index] = static_cast<int64_t>(CalculateRound(sequence));
+            break;
+        }
+    }
+
+    void SetAvailable(int64_t low_bound,int64_t high_bound) {
+        if(_option != kBitmapAvailableBuffer) {
+            for(int64_t sequence = low_bound; sequence <= high_bound; ++sequence) {
+                SetAvailable(sequence);
+            }
+            return;
+        }
+        // flip the bits of the batch word by word
+        int64_t sequence = low_bound;
+        while(sequence <= high_bound) {
+            const int64_t index = CalculateIndex(sequence);
+            const int64_t bit = index & 63;
+            const int64_t count = std::min(std::min(high_bound - sequence + 1L,64L - bit),
+                                           _buffer_size - index);
+            _bitmap_words[index >> 6].fetch_xor(BitMask(bit,count),
+                                                std::memory_order::memory_order_relaxed);
+            sequence += count;
+        }
+    }
+
+    bool IsAvailable(int64_t sequence) const {
+        const int64_t index = CalculateIndex(sequence);
+        const uint64_t round = CalculateRound(sequence);
+        switch (_option) {
+        case kCompactAvailableBuffer:
+            return _compact_flags[index] == static_cast<uint32_t>(round);
+        case kBitmapAvailableBuffer:
+            return ((_bitmap_words[index >> 6].load(std::memory_order::memory_order_relaxed)
+                        >> (index & 63)) & 1ULL) == (round & 1ULL);
+        case kWideAvailableBuffer:
+        default:
+            return _wide_flags[index] == static_cast<int64_t>(round);
+        }
+    }
+
+    /**
+     * @brief Get the highest sequence of [low_bound,high_bound] for which
+     * every sequence from low_bound is available, low_bound - 1 if none
+    */
+    int64_t GetHighestAvailable(int64_t low_bound,int64_t high_bound) const {
+        int64_t sequence = low_bound;
+        while(sequence <= high_bound) {
+            // Slots from index to the end of the buffer share the same round,
+            // the round increases by one when the index wraps to zero
+            const int64_t index = CalculateIndex(sequence);
+            const int64_t count = std::min(high_bound - sequence + 1L,_buffer_size - index);
+            const int64_t matched = CountAvailable(index,count,CalculateRound(sequence));
+            if(matched < count) {
+                return sequence + matched - 1L;
+            }
+            sequence += count;
+        }
+        return high_bound;
+    }
+
+private:
+    // Leading available slots of [index,index + count) in the given round
+    int64_t CountAvailable(int64_t index,int64_t count,uint64_t round) const {
+        switch (_option) {
+        case kCompactAvailableBuffer:
+            return util::CountEqualPrefix(_compact_flags + index,count,
+                                          static_cast<uint32_t>(round));
+        case kBitmapAvailableBuffer:
+            return CountAvailableBits(index,count,round);
+        case kWideAvailableBuffer:
+        default:
+            return util::CountEqualPrefix(_wide_flags + index,count,
+                                          static_cast<int64_t>(round));
+        }
+    }
+
+    int64_t CountAvailableBits(int64_t index,int64_t count,uint64_t round) const {
+        // bits equal to the parity of the round are available
+        const uint64_t expected = (round & 1ULL) ? ~0ULL : 0ULL;
+        int64_t matched = 0;
+        while(matched < count) {
+            const int64_t bit = (index + matched) & 63;
+            const int64_t bits = std::min(count - matched,64L - bit);
+            const uint64_t word = _bitmap_words[(index + matched) >> 6]
+                                    .load(std::memory_order::memory_order_relaxed);
+            const uint64_t unavailable = (word ^ expected) & BitMask(bit,bits);
+            if(unavailable) {
+                return matched + __builtin_ctzll(unavailable) - bit;
+            }
+            matched += bits;
+        }
+        return matched;
+    }
+
+    static uint64_t BitMask(int64_t bit,int64_t count) {
+        const uint64_t bits = (count >= 64) ? ~0ULL : ((1ULL << count) - 1ULL);
+        return bits << bit;
+    }
+
+    int64_t BitmapWordCount() const {
+        return (_buffer_size + 63) / 64;
+    }
+
+    int64_t CalculateIndex(int64_t sequence) const {
+        return sequence & _index_mask;
+    }
+
+    uint64_t CalculateRound(int64_t sequence) const {
+        return static_cast<uint64_t>(sequence) >> _index_shift;
+    }
+
+private:
+    AvailableBufferOption _option;
+    int64_t _buffer_size;
+    int64_t _index_mask;
+    int64_t _index_shift;
+    std::unique_ptr<MemoryRegion> _memory;
+    int64_t* _wide_flags;
+    uint32_t* _compact_flags;
+    std::atomic<uint64_t>* _bitmap_words;
+};
+
+} // end namespace disruptor
+
+#endif
@@ -0,0 +1,137 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_AVAILABLE_SCAN_H_
+#define DISRUPTOR_AVAILABLE_SCAN_H_
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "utils.h"
+
+namespace disruptor {
+namespace util {
+
+/**
+ * @brief Count the leading flags equal to expected, one flag per loop
+ * @param flags available buffer flags to scan
+ * @param count number of flags to scan
+ * @param expected flag of an available slot
+ * @return number of leading flags equal to expected, count if all match
+*/
+inline int64_t CountEqualPrefixScalar(const int64_t* flags,
+                                      int64_t count,
+                                      int64_t expected) {
+    int64_t i = 0;
+    while(i < count && flags[i] == expected) {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * @brief Count the leading flags equal to expected, comparing a block of
+ * flags per instruction when AVX2 or SSE2 is available.
+ * Build with -march=native(NATIVE option) to enable AVX2
+*/
+inline int64_t CountEqualPrefix(const int64_t* flags,
+                                int64_t count,
+                                int64_t expected) {
+    int64_t i = 0;
+#if defined(__AVX2__)
+    const __m256i target = _mm256_set1_epi64x(expected);
+    for(; i + 4 <= count; i += 4) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags + i));
+        // one bit per 64 bits lane
+        const int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(block,target)));
+        if(mask != 0xF) {
+            return i + __builtin_ctz(~mask);
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i target = _mm_set1_epi64x(expected);
+    for(; i + 2 <= count; i += 2) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(flags + i));
+        // SSE2 only compares 32 bits lanes, a 64 bits lane is equal when
+        // both of its halves are equal
+        const __m128i equal = _mm_cmpeq_epi32(block,target);
+        const __m128i halves = _mm_and_si128(equal,_mm_shuffle_epi32(equal,_MM_SHUFFLE(2,3,0,1)));
+        const int mask = _mm_movemask_pd(_mm_castsi128_pd(halves));
+        if(mask != 0x3) {
+            return i + __builtin_ctz(~mask);
+        }
+    }
+#endif
+    return i + CountEqualPrefixScalar(flags + i,count - i,expected);
+}
+
+/**
+ * @brief Count the leading 32 bits flags equal to expected, one flag per loop
+*/
+inline int64_t CountEqualPrefixScalar(const uint32_t* flags,
+                                      int64_t count,
+                                      uint32_t expected) {
+    int64_t i = 0;
+    while(i < count && flags[i] == expected) {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * @brief Count the leading 32 bits flags equal to expected, comparing a
+ * block of flags per instruction when AVX2 or SSE2 is available.
+*/
+inline int64_t CountEqualPrefix(const uint32_t* flags,
+                                int64_t count,
+                                uint32_t expected) {
+    int64_t i = 0;
+#if defined(__AVX2__)
+    const __m256i target = _mm256_set1_epi32(static_cast<int>(expected));
+    for(; i + 8 <= count; i += 8) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags + i));
+        const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block,target)));
+        if(mask != 0xFF) {
+            return i + __builtin_ctz(~mask);
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i target = _mm_set1_epi32(static_cast<int>(expected));
+    for(; i + 4 <= count; i += 4) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(flags + i));
+        const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block,target)));
+        if(mask != 0xF) {
+            return i + __builtin_ctz(~mask);
+        }
+    }
+#endif
+    return i + CountEqualPrefixScalar(flags + i,count - i,expected);
+}
+
+} // end namespace util
+} // end namespace disruptor
+
+#endif
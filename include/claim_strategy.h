@@ -26,20 +26,29 @@
 #ifndef DISRUPTOR_CLAIM_STRATEGY_H_
 #define DISRUPTOR_CLAIM_STRATEGY_H_
 
+#include <algorithm>
+#include <atomic>
 #include <thread>
 #include "sequence.h"
+#include "sequence_group.h"
 #include "ring_buffer.h"
+#include "available_buffer.h"
+#include "producer_wait_strategy.h"
 
 namespace disruptor {
 // Claim Startegy Option
 enum ClaimStrategyOption
 {
     kSingleThreadClaimStrategy,
-    kMultiThreadClaimStrategy
+    // Producers claim with a compare and set retry loop on the cursor
+    kMultiThreadClaimStrategy,
+    // Producers claim with a single fetch_add on the cursor and never retry
+    kMultiThreadFetchAddClaimStrategy
 };
 
 // Interface of ClaimStrategy
-// 可以改为CRTP模式实现
+// The concrete strategies are final, so a Sequencer instantiated with one
+// of them as a static policy calls it without virtual dispatch
 class ClaimStrategy
 {
 public:
@@ -49,14 +58,27 @@ public:
      * @param delta       sequences to claim [default: 1].
      * @return last claimed sequence
     */
-    virtual int64_t IncrementAndGet(const std::vector<Sequence*>& dependents,
+    virtual int64_t IncrementAndGet(const SequenceGroup& dependents,
                                     size_t delta = 1) = 0;
 
+    /**
+     * @brief Claim delta sequences only if the ring buffer has room for them,
+     * the capacity check and the claim are one operation
+     * @param dependents  dependents sequences to wait on (mostly consumers).
+     * @param delta       sequences to claim [default: 1].
+     * @return last claimed sequence, kInsufficientCapacitySignal if claiming
+     * would wrap over unconsumed events, nothing is claimed then
+    */
+    virtual int64_t TryIncrementAndGet(const SequenceGroup& dependents,
+                                       size_t delta = 1) = 0;
+
     /**
      * @brief Determine if there is enough space in the circular buffer
      * @param dependents Set of queues waiting for consumption of circular buffer data
+     * The answer may be stale by the time Next() is called with several
+     * publishers, use TryIncrementAndGet to check and claim at once
     */
-    virtual bool HasAvailableCapacity(const std::vector<Sequence*>& dependents) = 0;
+    virtual bool HasAvailableCapacity(const SequenceGroup& dependents) = 0;
 
     /**
      * @brief Published event
@@ -84,28 +106,50 @@ public:
     */
     virtual int64_t GetHighesetPublishedSequence(int64_t low_bound,
                             int64_t available_sequence) = 0;
+
+    /**
+     * @brief Forget the minimum of the gating sequences cached by the
+     * producers, called when the gating sequences are replaced so the next
+     * claim reads the new ones
+    */
+    virtual void InvalidateGatingCache() = 0;
+
+    /**
+     * @brief Whether several publishers may claim, their events are then
+     * marked available in an available buffer instead of by the cursor
+    */
+    virtual bool IsMultiProducer() const = 0;
 };
 
 // used internally
 // inline function allow multi define in file
+// available_option only applies to the multi thread strategies
+// producer_wait_strategy is not owned by the claim strategy
+// memory_policy allocates the available buffer of the multi thread strategies
 static inline ClaimStrategy* CreateClaimStrategy(ClaimStrategyOption option,
                                                  int64_t buffer_size,
-                                                 Sequence& cursor);
+                                                 Sequence& cursor,
+                                                 AvailableBufferOption available_option = kWideAvailableBuffer,
+                                                 ProducerWaitStrategy* producer_wait_strategy = DefaultProducerWaitStrategy(),
+                                                 const MemoryPolicy& memory_policy = MemoryPolicy());
 
 // Apply to a single publisher thread
 // Optimised strategy can be used when there is a single publisher thread.
-class SingleThreadStrategy : public ClaimStrategy
+class SingleThreadStrategy final : public ClaimStrategy
 {
     DISALLOW_COPY_MOVE_AND_ASSIGN(SingleThreadStrategy);
 public:
-    SingleThreadStrategy(int64_t buffer_size,Sequence& cursor) :
+    SingleThreadStrategy(int64_t buffer_size,
+                         Sequence& cursor,
+                         ProducerWaitStrategy* producer_wait_strategy = DefaultProducerWaitStrategy()) :
         _cursor(cursor),
         _buffer_size(buffer_size),
+        _producer_wait_strategy(producer_wait_strategy),
         _cursor_sequence_cache(kInitialCursorValue),
         _gating_sequence_cache(kInitialCursorValue) {}
     
     // producer batch processing
-    virtual int64_t IncrementAndGet(const std::vector<Sequence*>& dependents,
+    virtual int64_t IncrementAndGet(const SequenceGroup& dependents,
                                     size_t delta) override {
         // Get producer cursor and calcualte next available sequence
         // _cursor_sequence_cache is used to cached replace for cursor's sequence
@@ -116,28 +160,41 @@ public:
 
         // If the wrap_point is greater than the cached _gating_sequence_cache, 
         // it indicates that some consumers have not completed the processing and need to wait
-        if(wrap_point > _gating_sequence_cache) {
-            int64_t min_sequence;
+        if(wrap_point > _gating_sequence_cache.load(std::memory_order::memory_order_relaxed)) {
             // Waiting for non overlapping
-            while(wrap_point > (min_sequence = GetMinimumSequence(dependents))) {
-                std::this_thread::yield();
-            }
             // Cache the minimum serial number of consumers
-            _gating_sequence_cache = min_sequence;
+            _gating_sequence_cache.store(_producer_wait_strategy->WaitFor(wrap_point,dependents),
+                                         std::memory_order::memory_order_relaxed);
         }
         return _cursor_sequence_cache;
     }
 
-    virtual bool HasAvailableCapacity(const std::vector<Sequence*>& dependents) override {
+    virtual int64_t TryIncrementAndGet(const SequenceGroup& dependents,
+                                       size_t delta) override {
+        const int64_t next_sequence = _cursor_sequence_cache + delta;
+        const int64_t wrap_point = next_sequence - _buffer_size;
+        if(wrap_point > _gating_sequence_cache.load(std::memory_order::memory_order_relaxed)) {
+            const int64_t min_sequence = dependents.GetMinimumSequence(wrap_point);
+            _gating_sequence_cache.store(min_sequence,std::memory_order::memory_order_relaxed);
+            if(wrap_point > min_sequence) {
+                return kInsufficientCapacitySignal;
+            }
+        }
+        _cursor_sequence_cache = next_sequence;
+        return next_sequence;
+    }
+
+    virtual bool HasAvailableCapacity(const SequenceGroup& dependents) override {
         // The location that will be covered by the next allocation.
         const int64_t wrap_point = _cursor_sequence_cache - _buffer_size + 1L;
         // Availability is indicated when consumer's schedule meets:minsequence >= wrappoint
-        if(_gating_sequence_cache < wrap_point) {
+        if(_gating_sequence_cache.load(std::memory_order::memory_order_relaxed) < wrap_point) {
             // Update once comsumer's sequence if the consumer's 
             // sequence is already lower than wrap_point,it means
             // there is no avail space currently
-            _gating_sequence_cache = GetMinimumSequence(dependents);
-            if(_gating_sequence_cache < wrap_point) {
+            const int64_t min_sequence = dependents.GetMinimumSequence(wrap_point);
+            _gating_sequence_cache.store(min_sequence,std::memory_order::memory_order_relaxed);
+            if(min_sequence < wrap_point) {
                 return false;
             }
         }
@@ -161,71 +218,71 @@ public:
         return available_sequence;
     }
 
+    virtual void InvalidateGatingCache() override {
+        _gating_sequence_cache.store(kInitialCursorValue,std::memory_order::memory_order_relaxed);
+    }
+
+    virtual bool IsMultiProducer() const override {
+        return false;
+    }
+
 private:
+    // read by the consumers through IsAvailable
     Sequence& _cursor;
     int64_t _buffer_size;
+    ProducerWaitStrategy* _producer_wait_strategy;
+    int64_t _padding0[CACHE_LINE_PADDING_LENGTH];
+    // written by the producer on every claim
     int64_t _cursor_sequence_cache;
-    int64_t _gating_sequence_cache;
+    // atomic as InvalidateGatingCache is called by the thread replacing
+    // the gating sequences, relaxed accesses are plain moves on the claim
+    std::atomic<int64_t> _gating_sequence_cache;
+    int64_t _padding1[CACHE_LINE_PADDING_LENGTH];
 };
 
-// Apply to multi publisher thread
-// Optimised strategy can be used when there is a single publisher thread.
-class MultiThreadStrategy : public ClaimStrategy
+// Shared by the multi publisher strategies
+// With several publishers the cursor only records the highest claimed
+// sequence, the published sequences are tracked in the available buffer
+// whose layout is selected at construction
+class MultiThreadStrategyBase : public ClaimStrategy
 {
-    DISALLOW_COPY_MOVE_AND_ASSIGN(MultiThreadStrategy);
+    DISALLOW_COPY_MOVE_AND_ASSIGN(MultiThreadStrategyBase);
 public:
-    MultiThreadStrategy(int64_t buffer_size,Sequence& cursor) :
+    MultiThreadStrategyBase(int64_t buffer_size,
+                            Sequence& cursor,
+                            AvailableBufferOption available_option,
+                            ProducerWaitStrategy* producer_wait_strategy,
+                            const MemoryPolicy& memory_policy) :
         _cursor(cursor), 
         _buffer_size(buffer_size),
-        _available_buffer(new int64_t[buffer_size]) {
-        _index_mask = buffer_size - 1;
-        _index_shift = util::Log2(buffer_size);
-        InitialAvailableBuffer();
-    }
+        _producer_wait_strategy(producer_wait_strategy),
+        _available_buffer(buffer_size,available_option,memory_policy) {}
 
-    // May be used for mulit producers at the same time 
-    virtual int64_t IncrementAndGet(const std::vector<Sequence*>& dependents,
-                                    size_t delta) override {
-        // Try get next sequence
+    // Both multi thread strategies try to claim by compare and set, a
+    // fetch_add could not be undone when the ring buffer turns out full
+    virtual int64_t TryIncrementAndGet(const SequenceGroup& dependents,
+                                       size_t delta) override {
         int64_t current_sequence;
         int64_t next_sequence;
-        while(true) {
-            // Get cursor and expect value
+        do {
             current_sequence = _cursor.GetSequence();
             next_sequence = current_sequence + delta;
-            
-            // Calculate overlap point to prevent ring buffer wrapping
-            int64_t wrap_point = next_sequence - _buffer_size;
-
-            // Get cached minimum gating sequence
-            int64_t cached_gating_sequence = _gating_sequence_cache.GetSequence();
-
-            // If the wrap_point is greater than the cached _gating_sequence_cache, 
-            // it indicates that some consumers have not completed the processing and need to wait
-            if(wrap_point > cached_gating_sequence) {
-                // Get the last consumers sequence
-                int64_t min_sequence = GetMinimumSequence(dependents);
-
-                // Still overlap
+            const int64_t wrap_point = next_sequence - _buffer_size;
+            if(wrap_point > _gating_sequence_cache.GetSequence()) {
+                const int64_t min_sequence = dependents.GetMinimumSequence(wrap_point);
+                _gating_sequence_cache.SetSequence(min_sequence);
                 if(wrap_point > min_sequence) {
-                    std::this_thread::yield();
-                    continue;
+                    return kInsufficientCapacitySignal;
                 }
-                // If is not overlap,update cached_gating_sequence(last_consumer_sequence)
-                _gating_sequence_cache.SetSequence(min_sequence);
             }
-            // No overlap,directly set the _cursor to next_sequence
-            else if(_cursor.CompareAndSet(current_sequence,next_sequence)) {
-                break;
-            }
-        }
+        } while(!_cursor.CompareAndSet(current_sequence,next_sequence));
         return next_sequence;
     }
 
-    virtual bool HasAvailableCapacity(const std::vector<Sequence*>& dependents) override {
+    virtual bool HasAvailableCapacity(const SequenceGroup& dependents) override {
         const int64_t wrap_point = _cursor.GetSequence() - _buffer_size + 1L;
         if(_gating_sequence_cache.GetSequence() < wrap_point) {
-            const int64_t min_sequence = GetMinimumSequence(dependents);
+            const int64_t min_sequence = dependents.GetMinimumSequence(wrap_point);
             _gating_sequence_cache.SetSequence(min_sequence);
             if(min_sequence < wrap_point) {
                 return false;
@@ -235,72 +292,148 @@ public:
     }
 
     virtual void Publish(const int64_t& sequence) override {
-        SetAvailable(sequence);
+        // make the event visible before its flag
+        std::atomic_thread_fence(std::memory_order::memory_order_release);
+        _available_buffer.SetAvailable(sequence);
     }
 
     virtual void Publish(int64_t low_bound, int64_t high_bound) override {
-        for(int64_t seq = low_bound; seq <= high_bound; ++seq) {
-            SetAvailable(seq);
-        }
+        std::atomic_thread_fence(std::memory_order::memory_order_release);
+        _available_buffer.SetAvailable(low_bound,high_bound);
     }
 
     virtual int64_t GetHighesetPublishedSequence(int64_t low_bound,
                                                  int64_t available_sequence) override {
-        for(int64_t sequence = low_bound; sequence <= available_sequence; ++sequence) {
-            if(!IsAvailable(sequence)) {
-                return sequence - 1;
-            }
-        }
-        return available_sequence;
+        const int64_t highest = _available_buffer.GetHighestAvailable(low_bound,available_sequence);
+        // the events are read after their flags
+        std::atomic_thread_fence(std::memory_order::memory_order_acquire);
+        return highest;
     }
 
     virtual bool IsAvailable(const int64_t& sequence) override {
-        int64_t index = CalculateIndex(sequence);
-        int64_t flag = CalculateAvailableFlag(sequence);
-        return _available_buffer[index] == flag;
+        return _available_buffer.IsAvailable(sequence);
     }
 
-private:
-    void InitialAvailableBuffer() {
-        for(int64_t sequence = 0; sequence < _buffer_size; ++sequence) {
-            SetAvailableBufferFlag(sequence,-1);
-        }
+    virtual void InvalidateGatingCache() override {
+        _gating_sequence_cache.SetSequence(kInitialCursorValue);
     }
 
-    void SetAvailableBufferFlag(int64_t index,int64_t flag) {
-        _available_buffer[index] = flag;
-    }
-
-    void SetAvailable(int64_t sequence) {
-        SetAvailableBufferFlag(CalculateIndex(sequence),CalculateAvailableFlag(sequence));
-    }
-
-    int64_t CalculateIndex(int64_t sequence) {
-        return sequence & _index_mask;
+    virtual bool IsMultiProducer() const override {
+        return true;
     }
 
-    int64_t CalculateAvailableFlag(int64_t sequence) {
-        return static_cast<int64_t>(static_cast<uint64_t>(sequence) >> _index_shift);
+    const AvailableBuffer& GetAvailableBuffer() const {
+        return _available_buffer;
     }
 
-private:
+protected:
     Sequence& _cursor;
     int64_t _buffer_size;
     Sequence _gating_sequence_cache;
+    ProducerWaitStrategy* _producer_wait_strategy;
 
-    int64_t* _available_buffer;
-    int64_t _index_mask;
-    int64_t _index_shift;
+private:
+    AvailableBuffer _available_buffer;
 };
 
-static inline ClaimStrategy* CreateClaimStrategy(ClaimStrategyOption option,int64_t buffer_size,Sequence& cursor) {
+// Apply to multi publisher thread
+// Publishers claim by compare and set on the cursor and retry when
+// another publisher claimed first
+class MultiThreadStrategy final : public MultiThreadStrategyBase
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(MultiThreadStrategy);
+public:
+    MultiThreadStrategy(int64_t buffer_size,
+                            Sequence& cursor,
+                            AvailableBufferOption available_option = kWideAvailableBuffer,
+                            ProducerWaitStrategy* producer_wait_strategy = DefaultProducerWaitStrategy(),
+                            const MemoryPolicy& memory_policy = MemoryPolicy()) :
+        MultiThreadStrategyBase(buffer_size,cursor,available_option,producer_wait_strategy,memory_policy) {}
+
+    // May be used for mulit producers at the same time 
+    virtual int64_t IncrementAndGet(const SequenceGroup& dependents,
+                                    size_t delta) override {
+        // Try get next sequence
+        int64_t current_sequence;
+        int64_t next_sequence;
+        while(true) {
+            // Get cursor and expect value
+            current_sequence = _cursor.GetSequence();
+            next_sequence = current_sequence + delta;
+            
+            // Calculate overlap point to prevent ring buffer wrapping
+            int64_t wrap_point = next_sequence - _buffer_size;
+
+            // Get cached minimum gating sequence
+            int64_t cached_gating_sequence = _gating_sequence_cache.GetSequence();
+
+            // If the wrap_point is greater than the cached _gating_sequence_cache, 
+            // it indicates that some consumers have not completed the processing and need to wait
+            if(wrap_point > cached_gating_sequence) {
+                // Wait until the last consumers pass the wrap point, then
+                // update cached_gating_sequence(last_consumer_sequence)
+                // and claim again, the cursor may have moved meanwhile
+                _gating_sequence_cache.SetSequence(_producer_wait_strategy->WaitFor(wrap_point,dependents));
+            }
+            // No overlap,directly set the _cursor to next_sequence
+            else if(_cursor.CompareAndSet(current_sequence,next_sequence)) {
+                break;
+            }
+        }
+        return next_sequence;
+    }
+};
+
+// Apply to multi publisher thread
+// Publishers reserve their sequences with a single fetch_add on the cursor,
+// so a claim never retries however many publishers contend. The wrap point
+// is gated after the reservation: a publisher whose reserved sequences would
+// overwrite unconsumed events waits for the consumers before returning.
+// Consumers never read the reserved but unpublished sequences because their
+// available buffer flags still belong to the previous round.
+class MultiThreadFetchAddStrategy final : public MultiThreadStrategyBase
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(MultiThreadFetchAddStrategy);
+public:
+    MultiThreadFetchAddStrategy(int64_t buffer_size,
+                                    Sequence& cursor,
+                                    AvailableBufferOption available_option = kWideAvailableBuffer,
+                                    ProducerWaitStrategy* producer_wait_strategy = DefaultProducerWaitStrategy(),
+                            const MemoryPolicy& memory_policy = MemoryPolicy()) :
+        MultiThreadStrategyBase(buffer_size,cursor,available_option,producer_wait_strategy,memory_policy) {}
+
+    virtual int64_t IncrementAndGet(const SequenceGroup& dependents,
+                                    size_t delta) override {
+        // Reserve [next_sequence - delta + 1, next_sequence]
+        const int64_t next_sequence = _cursor.IncrementAndGet(delta);
+
+        // Calculate overlap point to prevent ring buffer wrapping
+        const int64_t wrap_point = next_sequence - _buffer_size;
+
+        // Only read the consumers when the cached gating sequence is behind
+        if(wrap_point > _gating_sequence_cache.GetSequence()) {
+            _gating_sequence_cache.SetSequence(_producer_wait_strategy->WaitFor(wrap_point,dependents));
+        }
+        return next_sequence;
+    }
+};
+
+static inline ClaimStrategy* CreateClaimStrategy(ClaimStrategyOption option,
+                                                 int64_t buffer_size,
+                                                 Sequence& cursor,
+                                                 AvailableBufferOption available_option,
+                                                 ProducerWaitStrategy* producer_wait_strategy,
+                                                 const MemoryPolicy& memory_policy) {
     ClaimStrategy* strategy = nullptr;
     switch (option) {
     case kSingleThreadClaimStrategy:
-        strategy = new SingleThreadStrategy(buffer_size,cursor);
+        strategy = new SingleThreadStrategy(buffer_size,cursor,producer_wait_strategy);
         break;
     case kMultiThreadClaimStrategy:
-        strategy = new MultiThreadStrategy(buffer_size,cursor);
+        strategy = new MultiThreadStrategy(buffer_size,cursor,available_option,producer_wait_strategy,memory_policy);
+        break;
+    case kMultiThreadFetchAddClaimStrategy:
+        strategy = new MultiThreadFetchAddStrategy(buffer_size,cursor,available_option,producer_wait_strategy,memory_policy);
         break;
     default:
         break;
@@ -308,6 +441,49 @@ static inline ClaimStrategy* CreateClaimStrategy(ClaimStrategyOption option,int6
     return strategy;
 }
 
+// Used by Sequencer to build its claim strategy: a concrete strategy type
+// is constructed directly, the ClaimStrategy interface falls back to the
+// runtime option
+template<typename C>
+struct ClaimStrategyBuilder
+{
+    static C* Build(ClaimStrategyOption option,
+                    int64_t buffer_size,
+                    Sequence& cursor,
+                    AvailableBufferOption available_option,
+                    ProducerWaitStrategy* producer_wait_strategy,
+                    const MemoryPolicy& memory_policy) {
+        return new C(buffer_size,cursor,available_option,producer_wait_strategy,memory_policy);
+    }
+};
+
+template<>
+struct ClaimStrategyBuilder<SingleThreadStrategy>
+{
+    static SingleThreadStrategy* Build(ClaimStrategyOption option,
+                                       int64_t buffer_size,
+                                       Sequence& cursor,
+                                       AvailableBufferOption available_option,
+                                       ProducerWaitStrategy* producer_wait_strategy,
+                                       const MemoryPolicy& memory_policy) {
+        return new SingleThreadStrategy(buffer_size,cursor,producer_wait_strategy);
+    }
+};
+
+template<>
+struct ClaimStrategyBuilder<ClaimStrategy>
+{
+    static ClaimStrategy* Build(ClaimStrategyOption option,
+                                int64_t buffer_size,
+                                Sequence& cursor,
+                                AvailableBufferOption available_option,
+                                ProducerWaitStrategy* producer_wait_strategy,
+                                const MemoryPolicy& memory_policy) {
+        return CreateClaimStrategy(option,buffer_size,cursor,available_option,
+                                   producer_wait_strategy,memory_policy);
+    }
+};
+
 } // end namespace disruptor
 
 #endif
\ No newline at end of file
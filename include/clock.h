@@ -0,0 +1,149 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_CLOCK_H_
+#define DISRUPTOR_CLOCK_H_
+
+#include <chrono>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "utils.h"
+
+namespace disruptor {
+
+// Monotonic clock of std::chrono::steady_clock, a vDSO call per read
+class SteadyClock
+{
+public:
+    static inline int64_t NowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+// Clock reading the time stamp counter, a few cycles per read. The counter
+// is calibrated against SteadyClock on first use, it needs an invariant TSC
+// (constant_tsc and nonstop_tsc in /proc/cpuinfo) synchronized between cores
+class TscClock
+{
+public:
+    static inline int64_t NowNanos() {
+        const Calibration& calibration = GetCalibration();
+        return calibration.base_nanos +
+            static_cast<int64_t>((__rdtsc() - calibration.base_ticks) * calibration.nanos_per_tick);
+    }
+
+private:
+    struct Calibration
+    {
+        uint64_t base_ticks;
+        int64_t base_nanos;
+        double nanos_per_tick;
+    };
+
+    static inline Calibration Calibrate() {
+        Calibration calibration;
+        calibration.base_nanos = SteadyClock::NowNanos();
+        calibration.base_ticks = __rdtsc();
+        int64_t nanos;
+        while((nanos = SteadyClock::NowNanos()) - calibration.base_nanos < 1000000L) {
+        }
+        const uint64_t ticks = __rdtsc();
+        calibration.nanos_per_tick = static_cast<double>(nanos - calibration.base_nanos) /
+                                     static_cast<double>(ticks - calibration.base_ticks);
+        return calibration;
+    }
+
+    static inline const Calibration& GetCalibration() {
+        static const Calibration calibration = Calibrate();
+        return calibration;
+    }
+};
+#endif
+
+// Clock of the timed waits, build with -DDISRUPTOR_TSC_CLOCK(TSC_CLOCK
+// option) to use the time stamp counter on x86
+#if defined(DISRUPTOR_TSC_CLOCK) && (defined(__x86_64__) || defined(__i386__))
+using WaitClock = TscClock;
+#else
+using WaitClock = SteadyClock;
+#endif
+
+// calls of Deadline::Expired() between two reads of the clock
+constexpr int64_t kDefaultDeadlineCheckInterval = 64L;
+
+/**
+ * @brief Deadline of a timed wait on WaitClock
+ * @param C clock with a static NowNanos(), e.g. a fake clock in tests
+ * @example Deadline deadline(timeout);
+ *      while(!ready()) {
+ *          if(deadline.Expired()) return kTimeoutSignal;
+ *      }
+*/
+template<typename C>
+class BasicDeadline
+{
+public:
+    explicit BasicDeadline(const std::chrono::nanoseconds& timeout,
+                           int64_t check_interval = kDefaultDeadlineCheckInterval)
+        : _deadline_nanos(C::NowNanos() + timeout.count()),
+          _check_interval(check_interval),
+          _counter(check_interval) {}
+
+    // Only reads the clock every check_interval calls, for spin loops
+    inline bool Expired() {
+        if(--_counter > 0) {
+            return false;
+        }
+        _counter = _check_interval;
+        return ExpiredNow();
+    }
+
+    // Reads the clock, for loops which yield or sleep between checks
+    inline bool ExpiredNow() const {
+        return C::NowNanos() >= _deadline_nanos;
+    }
+
+    // Nanoseconds left, negative once expired
+    inline int64_t RemainingNanos() const {
+        return _deadline_nanos - C::NowNanos();
+    }
+
+private:
+    int64_t _deadline_nanos;
+    int64_t _check_interval;
+    int64_t _counter;
+};
+
+using Deadline = BasicDeadline<WaitClock>;
+
+} // end namespace disruptor
+
+#endif
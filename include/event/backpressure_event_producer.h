@@ -0,0 +1,195 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_BACKPRESSURE_EVENT_PRODUCER_H_
+#define DISRUPTOR_BACKPRESSURE_EVENT_PRODUCER_H_
+
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include "clock.h"
+#include "sequencer.h"
+#include "event/event_interface.h"
+
+namespace disruptor {
+// What a BackpressureEventProducer does when the ring buffer is full
+enum BackpressurePolicy
+{
+    // Return false, the caller keeps the event and may retry
+    kFailOnFull,
+    // Discard the event being published
+    kDropNewestOnFull,
+    // Claim anyway and overwrite the oldest events. Only for a sequencer
+    // without gating sequences, whose readers may lose events, and with a
+    // single thread claim strategy: the readers of a multi thread one have
+    // no lap detection, one a lap behind stalls or reads a torn slot
+    kOverwriteOldestOnFull,
+    // Retry until the wait timeout, then fail
+    kWaitWithTimeoutOnFull
+};
+
+// Outcomes counted by a BackpressureEventProducer, in events
+struct BackpressureCounters
+{
+    int64_t published = 0;
+    int64_t rejected = 0;
+    int64_t dropped = 0;
+    int64_t overwritten = 0;
+    int64_t timed_out = 0;
+};
+
+/**
+ * @brief Producer which never blocks on a full ring buffer for longer than
+ * its policy allows. Claims go through Sequencer::TryNext(), which checks
+ * the capacity and claims in one operation.
+ *
+ * With kOverwriteOldestOnFull the sequencer has no gating sequences so the
+ * claim always succeeds. The readers' sequences are given to
+ * SetObservedSequences() instead, only to count the events overwritten
+ * before every reader consumed them. The sequencer must not be multi
+ * producer, the constructor asserts it.
+ *
+ * A BackpressureEventProducer must only be used by one thread.
+*/
+template<typename T,typename S = Sequencer<T>>
+class BackpressureEventProducer
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(BackpressureEventProducer);
+public:
+    explicit BackpressureEventProducer(S* sequencer,
+                                       BackpressurePolicy policy = kFailOnFull,
+                                       const std::chrono::microseconds& wait_timeout = std::chrono::microseconds(100L))
+        : _sequencer(sequencer),
+          _policy(policy),
+          _wait_timeout(wait_timeout) {
+        assert(policy != kOverwriteOldestOnFull || !sequencer->IsMultiProducer());
+    }
+
+    // Set the sequences of the readers of a stream which does not gate
+    // the sequencer, used by kOverwriteOldestOnFull
+    void SetObservedSequences(const std::vector<Sequence*>& sequences) {
+        _observed_sequences = sequences;
+    }
+
+    // Translate and publish batch_size events
+    // return false if the policy gave up on a full ring buffer
+    bool TryPublishEvent(EventTranslator<T>* translator,int64_t batch_size = 1) {
+        const int64_t last_available_sequence = Claim(batch_size);
+        if(last_available_sequence == kInsufficientCapacitySignal) {
+            return false;
+        }
+        const int64_t first_available_sequence = last_available_sequence - batch_size + 1L;
+        for(int64_t sequence = first_available_sequence; sequence <= last_available_sequence; ++sequence) {
+            translator->TranslateTo(sequence,(*_sequencer)[sequence]);
+        }
+        _sequencer->Publish(first_available_sequence,last_available_sequence);
+        _counters.published += batch_size;
+        return true;
+    }
+
+    // Move the event into the ring buffer, it is left untouched on failure
+    bool TryPublishEvent(T* event) {
+        const int64_t sequence = Claim(1L);
+        if(sequence == kInsufficientCapacitySignal) {
+            return false;
+        }
+        *(*_sequencer)[sequence] = std::move(*event);
+        _sequencer->Publish(sequence);
+        ++_counters.published;
+        return true;
+    }
+
+    const BackpressureCounters& GetCounters() const {
+        return _counters;
+    }
+
+    BackpressurePolicy GetPolicy() const {
+        return _policy;
+    }
+
+private:
+    // Claim batch_size sequences applying the policy
+    // return the last claimed sequence or kInsufficientCapacitySignal
+    int64_t Claim(int64_t batch_size) {
+        if(_policy == kOverwriteOldestOnFull) {
+            return ClaimOverwrite(batch_size);
+        }
+        int64_t sequence = _sequencer->TryNext(batch_size);
+        if(sequence != kInsufficientCapacitySignal) {
+            return sequence;
+        }
+        switch (_policy) {
+        case kDropNewestOnFull:
+            _counters.dropped += batch_size;
+            break;
+        case kWaitWithTimeoutOnFull:
+            sequence = ClaimBeforeTimeout(batch_size);
+            if(sequence == kInsufficientCapacitySignal) {
+                _counters.timed_out += batch_size;
+            }
+            break;
+        default:
+            _counters.rejected += batch_size;
+            break;
+        }
+        return sequence;
+    }
+
+    int64_t ClaimOverwrite(int64_t batch_size) {
+        const int64_t sequence = _sequencer->Next(batch_size);
+        if(!_observed_sequences.empty()) {
+            // sequence overwrites the event of sequence - buffer size
+            const int64_t overwrite_point = sequence - _sequencer->GetBufferSize();
+            const int64_t overwritten = overwrite_point - GetMinimumSequence(_observed_sequences);
+            if(overwritten > 0) {
+                _counters.overwritten += std::min(overwritten,batch_size);
+            }
+        }
+        return sequence;
+    }
+
+    int64_t ClaimBeforeTimeout(int64_t batch_size) {
+        const Deadline deadline(_wait_timeout);
+        int64_t sequence;
+        while((sequence = _sequencer->TryNext(batch_size)) == kInsufficientCapacitySignal) {
+            if(deadline.ExpiredNow()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        return sequence;
+    }
+
+private:
+    S* _sequencer;
+    BackpressurePolicy _policy;
+    std::chrono::microseconds _wait_timeout;
+    std::vector<Sequence*> _observed_sequences;
+    BackpressureCounters _counters;
+};
+
+} // end namespace disruptor
+
+#endif
@@ -0,0 +1,163 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_CHUNKED_EVENT_PRODUCER_H_
+#define DISRUPTOR_CHUNKED_EVENT_PRODUCER_H_
+
+#include <cassert>
+#include <chrono>
+#include "clock.h"
+#include "sequencer.h"
+#include "event/event_interface.h"
+
+namespace disruptor {
+
+constexpr int64_t kDefaultChunkSize = 64L;
+// claims between two reads of the clock for the flush timeout
+constexpr int64_t kChunkFlushCheckInterval = 8L;
+
+/**
+ * @brief Producer handle for one publisher thread which reserves sequences
+ * from the sequencer a chunk at a time and hands them out locally, so the
+ * shared cursor is only touched once per chunk instead of once per event.
+ * Every event is still published on its own (through the available buffer
+ * with a multi thread strategy) as soon as it is written.
+ *
+ * Consumers read in sequence order, so the unused sequences of a chunk hold
+ * back the events of the other publishers claimed after it. Flush() publishes
+ * them as padding events filled by the padding translator, which must mark
+ * them so that handlers recognize and skip them.
+ *
+ * The flush timeout is enforced on the claim path only: Next() flushes a
+ * chunk claimed longer than the timeout ago(the clock is read every
+ * kChunkFlushCheckInterval claims), so a slow publisher holds the others
+ * back about the timeout at most. Nothing else runs on the publisher's
+ * chunk, a publisher which goes idle holds consumers back until it calls
+ * Flush(), or polls FlushIfExpired(). The destructor flushes.
+ *
+ * A ChunkedEventProducer must only be used by one thread.
+ * @param C clock of the flush timeout, see BasicDeadline
+*/
+template<typename T,typename S = Sequencer<T>,typename C = WaitClock>
+class ChunkedEventProducer
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(ChunkedEventProducer);
+public:
+    // padding_translator marks the padding events, it must not be null
+    // a chunk fits in the ring buffer, a larger one could never be claimed
+    explicit ChunkedEventProducer(S* sequencer,
+                                  EventTranslator<T>* padding_translator,
+                                  int64_t chunk_size = kDefaultChunkSize,
+                                  const std::chrono::microseconds& flush_timeout = std::chrono::microseconds(100L))
+        : _sequencer(sequencer),
+          _chunk_size(chunk_size),
+          _flush_timeout(flush_timeout),
+          _padding_translator(padding_translator),
+          _next_sequence(kFirstSequenceValue),
+          _chunk_end_sequence(kInitialCursorValue),
+          _chunk_deadline(flush_timeout,kChunkFlushCheckInterval) {
+        assert(padding_translator != nullptr);
+        assert(chunk_size > 0 && chunk_size <= sequencer->GetBufferSize());
+    }
+
+    ~ChunkedEventProducer() {
+        Flush();
+    }
+
+    // Get the next sequence of the chunk, claim a new chunk when it is used
+    // up or has expired
+    int64_t Next() {
+        if(_next_sequence <= _chunk_end_sequence && _chunk_deadline.Expired()) {
+            Flush();
+        }
+        if(_next_sequence > _chunk_end_sequence) {
+            _chunk_end_sequence = _sequencer->Next(_chunk_size);
+            _next_sequence = _chunk_end_sequence - _chunk_size + 1L;
+            _chunk_deadline = BasicDeadline<C>(_flush_timeout,kChunkFlushCheckInterval);
+        }
+        return _next_sequence++;
+    }
+
+    // Publish a sequence returned by Next()
+    void Publish(const int64_t& sequence) {
+        _sequencer->Publish(sequence);
+    }
+
+    void PublishEvent(EventTranslator<T>* translator) {
+        const int64_t sequence = Next();
+        translator->TranslateTo(sequence,(*_sequencer)[sequence]);
+        Publish(sequence);
+    }
+
+    void PublishEvent(T* event) {
+        const int64_t sequence = Next();
+        *(*_sequencer)[sequence] = std::move(*event);
+        Publish(sequence);
+    }
+
+    // Publish the unused sequences of the current chunk as padding events
+    void Flush() {
+        if(_next_sequence > _chunk_end_sequence) {
+            return;
+        }
+        for(int64_t sequence = _next_sequence; sequence <= _chunk_end_sequence; ++sequence) {
+            _padding_translator->TranslateTo(sequence,(*_sequencer)[sequence]);
+        }
+        _sequencer->Publish(_next_sequence,_chunk_end_sequence);
+        _next_sequence = _chunk_end_sequence + 1L;
+    }
+
+    // Flush the current chunk if it was claimed longer than the timeout ago,
+    // for an idle publisher thread, which does not claim
+    // return true if the chunk was flushed
+    bool FlushIfExpired() {
+        if(_next_sequence > _chunk_end_sequence) {
+            return false;
+        }
+        if(!_chunk_deadline.ExpiredNow()) {
+            return false;
+        }
+        Flush();
+        return true;
+    }
+
+    // Number of sequences left in the current chunk
+    int64_t RemainingInChunk() const {
+        return _chunk_end_sequence - _next_sequence + 1L;
+    }
+
+private:
+    S* _sequencer;
+    int64_t _chunk_size;
+    std::chrono::microseconds _flush_timeout;
+    EventTranslator<T>* _padding_translator;
+    int64_t _next_sequence;
+    int64_t _chunk_end_sequence;
+    BasicDeadline<C> _chunk_deadline;
+};
+
+} // end namespace disruptor
+
+#endif
@@ -27,7 +27,10 @@
 #define DISRUPTOR_EVENT_INTERFACE_H_
 
 #include <atomic>
+#include <type_traits>
+#include <utility>
 #include "sequence.h"
+#include "slot_span.h"
 
 namespace disruptor {
 template<typename T>
@@ -44,6 +47,35 @@ public:
     virtual void OnShutdown() = 0;
 };
 
+// Handler calling f(sequence,event) per event, without virtual dispatch:
+//     auto handler = MakeEventHandler<Event>([&count](const int64_t& sequence,Event* event){
+//         ++count;
+//     });
+//     EventProcessor<Event,Sequencer<Event>,decltype(handler)> processor(sequencer,barrier,&handler);
+template<typename T,typename F>
+class CallableEventHandler
+{
+public:
+    explicit CallableEventHandler(F f) : _f(std::move(f)) {}
+
+    inline void OnEvent(const int64_t& sequence, T* event) {
+        _f(sequence,event);
+    }
+
+    void OnStart() {}
+
+    void OnShutdown() {}
+
+private:
+    F _f;
+};
+
+template<typename T,typename F>
+CallableEventHandler<T,typename std::decay<F>::type> MakeEventHandler(F&& f)
+{
+    return CallableEventHandler<T,typename std::decay<F>::type>(std::forward<F>(f));
+}
+
 template<typename T>
 class EventTranslator
 {
@@ -51,6 +83,19 @@ public:
     // Translate a data representation into fields set in given event
     virtual T* TranslateTo(const int64_t& sequence, T* event) = 0;
 };
+
+// Translates an array of inputs A into the events of a claimed range
+template<typename T,typename A>
+class EventTranslatorBatch
+{
+public:
+    // Translate inputs[0,events.size) into the events of the sequences
+    // from first_sequence on, called once per contiguous run of slots of
+    // the claimed range(at most twice with the packed slot layout)
+    virtual void TranslateTo(const A* inputs,
+                             const int64_t& first_sequence,
+                             const SlotSpan<T>& events) = 0;
+};
 } // end namespace disruptor
 
 
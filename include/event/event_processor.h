@@ -26,28 +26,45 @@
 #ifndef DISRUPTOR_EVENT_CONSUMER_H_
 #define DISRUPTOR_EVENT_CONSUMER_H_
 
+#include "gating_tree.h"
 #include "sequencer.h"
 #include "event/event_interface.h"
 
 namespace disruptor {
 
-template<typename T>
+// S is the Sequencer type, its barrier type follows the same strategies.
+// H is the handler type, by default the virtual EventHandler<T>. Any type
+// with OnEvent/OnStart/OnShutdown works: with a final handler class, or
+// one not derived from EventHandler<T>, OnEvent is called directly and
+// inlined into the batch loop
+template<typename T,typename S = Sequencer<T>,typename H = EventHandler<T>>
 class EventProcessor
 {
     DISALLOW_COPY_MOVE_AND_ASSIGN(EventProcessor);
 public:
-    explicit EventProcessor(Sequencer<T>* sequencer,
-                           SequenceBarrier* sequence_barrier,
-                           EventHandler<T>* event_handler)
+    using Barrier = typename S::Barrier;
+
+    explicit EventProcessor(S* sequencer,
+                           Barrier* sequence_barrier,
+                           H* event_handler)
         : _running(false),
           _sequencer(sequencer),
           _sequence_barrier(sequence_barrier),
-          _event_handler(event_handler) {}
+          _event_handler(event_handler),
+          _gating_tree(nullptr),
+          _gating_leaf(0) {}
 
     Sequence* GetSequence() {
         return &_sequence;
     }
 
+    // Aggregate the sequence into a gating tree the producers are gated
+    // on, leaf is the index of GetSequence() in the tree's leaves
+    void SetGatingTree(GatingTree* gating_tree,size_t leaf) {
+        _gating_tree = gating_tree;
+        _gating_leaf = leaf;
+    }
+
     void Run() {
         if(_running.load()) {
             return;
@@ -68,6 +85,11 @@ public:
             }
             // _sequence.SetSequence(next_sequence - 1L);
             _sequence.SetSequence(available_sequence);
+            if(_gating_tree != nullptr) {
+                _gating_tree->Update(_gating_leaf);
+            }
+            _sequence_barrier->SignalWhenBlocking(_sequence);
+            _sequencer->SignalProducersWhenBlocking();
             if(!_running.load()) {
                 break;
             }
@@ -88,9 +110,11 @@ public:
 private:
     std::atomic<bool> _running;
     Sequence _sequence;
-    Sequencer<T>* _sequencer;
-    SequenceBarrier* _sequence_barrier;
-    EventHandler<T>* _event_handler;
+    S* _sequencer;
+    Barrier* _sequence_barrier;
+    H* _event_handler;
+    GatingTree* _gating_tree;
+    size_t _gating_leaf;
 };
 
 } // end namespace disruptor
@@ -29,30 +29,67 @@
 #include "sequencer.h"
 #include "event/event_interface.h"
 
+#include <algorithm>
 #include <cstring>
+#include <type_traits>
+#include <utility>
 
 namespace disruptor {
-template<typename T>
+// S is the Sequencer type the events are published to
+template<typename T,typename S = Sequencer<T>>
 class EventProducer
 {
     DISALLOW_COPY_MOVE_AND_ASSIGN(EventProducer);
 public:
-    explicit EventProducer(Sequencer<T>* sequencer)
+    explicit EventProducer(S* sequencer)
         : _sequencer(sequencer) {}
 
     // Three statage
     // Call Next() get a sequence,then translator data into ringbuffer
     // and finally publish the event
+    // The whole batch is published at once: one cursor store(or one
+    // available buffer update) and one wake up of the consumers
     void PublishEvent(EventTranslator<T>* translator,int64_t batch_size = 1) {
         int64_t last_available_sequence = _sequencer->Next(batch_size);
         int64_t first_available_sequence = last_available_sequence - batch_size + 1L;
         for(int64_t sequence = first_available_sequence; sequence <= last_available_sequence; ++sequence) {
             T* event = (*_sequencer)[sequence];
             translator->TranslateTo(sequence,event);
-            _sequencer->Publish(sequence);
         }
-        // ///@bug only publish last_sequence in multiProducer
-        // _sequencer->Publish(last_available_sequence);
+        // Publish(last_available_sequence) would only mark the last
+        // sequence available with several producers, publish the range
+        _sequencer->Publish(first_available_sequence,last_available_sequence);
+    }
+
+    /**
+     * @brief Publish one event translated by a callable, which the compiler
+     * inlines in the claim and publish: no virtual call per event and no
+     * translator class per message type
+     *      producer.PublishEvent([](const int64_t& sequence,Event* event,int64_t price){
+     *          event->price = price;
+     *      },price);
+     * @param f called as f(sequence,event,args...)
+    */
+    template<typename F,typename... Args>
+    auto PublishEvent(F&& f,Args&&... args)
+        -> decltype(f(std::declval<const int64_t&>(),std::declval<T*>(),std::forward<Args>(args)...),void()) {
+        const int64_t sequence = _sequencer->Next(1);
+        f(sequence,(*_sequencer)[sequence],std::forward<Args>(args)...);
+        _sequencer->Publish(sequence);
+    }
+
+    // Claim count sequences and hand the inputs to the translator with
+    // the claimed slots, a contiguous run at a time. The batch is
+    // published once
+    template<typename A>
+    void PublishEvents(EventTranslatorBatch<T,A>* translator,const A* inputs,int64_t count) {
+        const int64_t last_available_sequence = _sequencer->Next(count);
+        const int64_t first_available_sequence = last_available_sequence - count + 1L;
+        ForEachSpan(first_available_sequence,last_available_sequence,
+                    [translator,inputs](int64_t offset,int64_t sequence,const SlotSpan<T>& span){
+            translator->TranslateTo(inputs + offset,sequence,span);
+        });
+        _sequencer->Publish(first_available_sequence,last_available_sequence);
     }
 
     void PublishEvent(T* event, int64_t batch_size = 1) {
@@ -66,17 +103,51 @@ public:
         _sequencer->Publish(first_available_sequence, last_available_sequence);
     }
 
+    // Claim count sequences and copy the events into their slots a
+    // contiguous span at a time, trivially copyable events are copied
+    // with memcpy. The batch is published once
+    void PublishEvents(const T* events, int64_t count) {
+        const int64_t last_available_sequence = _sequencer->Next(count);
+        const int64_t first_available_sequence = last_available_sequence - count + 1L;
+        ForEachSpan(first_available_sequence,last_available_sequence,
+                    [this,events](int64_t offset,int64_t sequence,const SlotSpan<T>& span){
+            CopyEvents(events + offset, span,
+                       std::integral_constant<bool,std::is_trivially_copyable<T>::value>());
+        });
+        _sequencer->Publish(first_available_sequence, last_available_sequence);
+    }
+
 private:
+    // Call f(offset in the batch,first sequence,span) for each contiguous
+    // run of slots of the claimed range
+    template<typename F>
+    void ForEachSpan(int64_t low_bound,int64_t high_bound,F f) {
+        int64_t sequence = low_bound;
+        while(sequence <= high_bound) {
+            const SlotSpan<T> span = _sequencer->GetSpan(sequence,high_bound - sequence + 1L);
+            f(sequence - low_bound,sequence,span);
+            sequence += span.size;
+        }
+    }
+
     void PublishEventImpl(T* event, T* slot, std::true_type) {
         *slot = std::move(*event);
     }
 
     void PublishEventImpl(T* event, T* slot, std::false_type) {
-        memcpy((char*)&slot, (char*)event, sizeof(T));
+        memcpy(static_cast<void*>(slot), static_cast<const void*>(event), sizeof(T));
+    }
+
+    void CopyEvents(const T* events, const SlotSpan<T>& span, std::true_type) {
+        memcpy(static_cast<void*>(span.data), static_cast<const void*>(events), span.size * sizeof(T));
+    }
+
+    void CopyEvents(const T* events, const SlotSpan<T>& span, std::false_type) {
+        std::copy(events, events + span.size, span.data);
     }
 
 private:
-    Sequencer<T>* _sequencer;
+    S* _sequencer;
 };
 } // end namespace disruptor
 
@@ -0,0 +1,135 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_SHARDED_EVENT_PROCESSOR_H_
+#define DISRUPTOR_SHARDED_EVENT_PROCESSOR_H_
+
+#include "sharded_sequencer.h"
+#include "event/event_interface.h"
+
+namespace disruptor {
+
+/**
+ * @brief Consumer of a ShardedSequencer merging its shards round robin:
+ * each pass handles the events published on every shard since the previous
+ * pass, shard after shard. Events of one shard keep their publish order,
+ * there is no order between shards.
+ *
+ * Each shard gates its publisher with its own sequence. Between passes the
+ * processor waits on a ShardedSequenceBarrier, through the wait strategy W
+ * of the sequencer. H is the handler type, as for EventProcessor.
+*/
+template<typename T,typename W = BusySpinStrategy,typename H = EventHandler<T>>
+class ShardedEventProcessor
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(ShardedEventProcessor);
+public:
+    using ShardedSequencerType = ShardedSequencer<T,W>;
+    using Shard = typename ShardedSequencerType::Shard;
+
+    explicit ShardedEventProcessor(ShardedSequencerType* sequencer,
+                                   H* event_handler)
+        : _running(false),
+          _sequencer(sequencer),
+          _sequence_barrier(sequencer->NewBarrier()),
+          _event_handler(event_handler) {
+        std::vector<Sequence*> gating_sequences;
+        for(size_t i = 0; i < sequencer->GetShardCount(); ++i) {
+            _sequences.push_back(new Sequence());
+            gating_sequences.push_back(_sequences.back());
+        }
+        sequencer->AddGatingSequences(gating_sequences);
+    }
+
+    ~ShardedEventProcessor() {
+        delete _sequence_barrier;
+        for(Sequence* sequence : _sequences) {
+            delete sequence;
+        }
+    }
+
+    // Sequence of the events handled on a shard
+    Sequence* GetSequence(size_t shard) {
+        return _sequences[shard];
+    }
+
+    void Run() {
+        if(_running.load()) {
+            return;
+        }
+        _running.store(true);
+        _sequence_barrier->SetAlerted(false);
+        _event_handler->OnStart();
+
+        const size_t shard_count = _sequences.size();
+        std::vector<int64_t> next_sequences(shard_count);
+        std::vector<int64_t> available_sequences(shard_count);
+        for(size_t i = 0; i < shard_count; ++i) {
+            next_sequences[i] = _sequences[i]->GetSequence() + 1L;
+        }
+        while(_sequence_barrier->WaitFor(next_sequences,available_sequences)) {
+            for(size_t i = 0; i < shard_count; ++i) {
+                const int64_t available_sequence = available_sequences[i];
+                int64_t next_sequence = next_sequences[i];
+                if(available_sequence < next_sequence) {
+                    continue;
+                }
+                Shard* shard = _sequencer->GetShard(i);
+                while(next_sequence <= available_sequence) {
+                    _event_handler->OnEvent(next_sequence,(*shard)[next_sequence]);
+                    ++next_sequence;
+                }
+                _sequences[i]->SetSequence(available_sequence);
+                shard->SignalProducersWhenBlocking();
+                next_sequences[i] = next_sequence;
+            }
+            if(!_running.load()) {
+                break;
+            }
+        }
+        _event_handler->OnShutdown();
+        _running.store(false);
+    }
+
+    void Stop() {
+        if(!_running.load()) {
+            return;
+        }
+        _running.store(false);
+        _sequence_barrier->SetAlerted(true);
+        _sequence_barrier->SignalAllWhenBlocking();
+    }
+
+private:
+    std::atomic<bool> _running;
+    ShardedSequencerType* _sequencer;
+    typename ShardedSequencerType::Barrier* _sequence_barrier;
+    H* _event_handler;
+    std::vector<Sequence*> _sequences;
+};
+
+} // end namespace disruptor
+
+#endif
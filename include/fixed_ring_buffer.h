@@ -0,0 +1,182 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_FIXED_RING_BUFFER_H_
+#define DISRUPTOR_FIXED_RING_BUFFER_H_
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include "ring_buffer.h"
+
+namespace disruptor {
+
+// fixed rings up to this size are stored inside the FixedRingBuffer
+constexpr size_t kMaxInlineRingBufferBytes = 64 * 1024;
+
+// used internally
+// Storage of the slots of a FixedRingBuffer, inline or in a MemoryRegion
+template<typename T,size_t N,bool Inline>
+class FixedSlotStorage;
+
+template<typename T,size_t N>
+class FixedSlotStorage<T,N,true>
+{
+public:
+    explicit FixedSlotStorage(const MemoryPolicy& memory_policy) {}
+
+    inline char* Data() {
+        return reinterpret_cast<char*>(&_storage);
+    }
+
+private:
+    typename std::aligned_storage<sizeof(T) * N,alignof(T)>::type _storage;
+};
+
+template<typename T,size_t N>
+class FixedSlotStorage<T,N,false>
+{
+public:
+    // the slots start a false sharing range, or on the alignment of T
+    explicit FixedSlotStorage(const MemoryPolicy& memory_policy)
+        : _memory(new MemoryRegion(sizeof(T) * N,memory_policy,
+                                   std::max<size_t>(alignof(T),FALSE_SHARING_RANGE_IN_BYTES))),
+          _data(static_cast<char*>(_memory->GetAddress())) {}
+
+    inline char* Data() {
+        return _data;
+    }
+
+private:
+    std::unique_ptr<MemoryRegion> _memory;
+    char* _data;
+};
+
+/**
+ * @brief RingBuffer whose capacity is a template parameter: the index mask
+ * is a constant and small rings(up to kMaxInlineRingBufferBytes) are
+ * stored inline, so operator[] reads no member
+ * @param T EventType
+ * @param N capacity, a power of 2
+ * The slots are always packed. The constructor takes the parameters of
+ * RingBuffer but the size, which is N, and the slot layout;
+ * kParallelSlotInit constructs serially
+*/
+template<typename T,size_t N>
+class FixedRingBuffer
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(FixedRingBuffer);
+    static_assert(N > 0 && (N & (N - 1)) == 0,"FixedRingBuffer's size must be a positive power of 2");
+public:
+    static constexpr int64_t kCapacity = static_cast<int64_t>(N);
+    static constexpr int64_t kIndexMask = kCapacity - 1;
+    static constexpr bool kInline = sizeof(T) * N <= kMaxInlineRingBufferBytes;
+
+    explicit FixedRingBuffer(const MemoryPolicy& memory_policy = MemoryPolicy(),
+                             const SlotInitPolicy<T>& slot_init = SlotInitPolicy<T>())
+        : _storage(memory_policy) {
+        if(slot_init.option == kLazySlotInit &&
+                slot_init.factory == nullptr &&
+                IsLazySlotInitSupported<T>::value) {
+            return;
+        }
+        for(int64_t i = 0; i < kCapacity; ++i) {
+            if(slot_init.factory != nullptr) {
+                slot_init.factory->NewInstance(i,Slot(i));
+            }
+            else {
+                new (Slot(i)) T();
+            }
+        }
+    }
+
+    ~FixedRingBuffer() {
+        for(int64_t i = 0; i < kCapacity; ++i) {
+            Slot(i)->~T();
+        }
+    }
+
+    /**
+     * @brief Get the event for a given sequence in the RingBuffer
+     * @param sequence sequence for the event(increase from zero)
+     * @return event referenced at the specified sequence position
+     */
+    inline T* operator[](const int64_t& sequence) {
+        return Slot(sequence & kIndexMask);
+    }
+
+    // Number of events in the RingBuffer
+    int64_t GetSize() const {
+        return kCapacity;
+    }
+
+    // Get the contiguous slots of up to count sequences from sequence on
+    SlotSpan<T> GetSpan(int64_t sequence,int64_t count) {
+        const int64_t index = sequence & kIndexMask;
+        return SlotSpan<T>(Slot(index),std::min(count,kCapacity - index));
+    }
+
+    // Where the slots are
+    SlotAddressing<T> GetSlotAddressing() {
+        return SlotAddressing<T>(_storage.Data(),kCapacity);
+    }
+
+    SlotLayoutOption GetSlotLayout() const {
+        return kPackedSlotLayout;
+    }
+
+    // Bytes used by the slots
+    size_t MemorySize() const {
+        return sizeof(T) * N;
+    }
+
+private:
+    inline T* Slot(int64_t index) {
+        return reinterpret_cast<T*>(_storage.Data()) + index;
+    }
+
+    FixedSlotStorage<T,N,kInline> _storage;
+};
+
+// used internally
+// Whether R is sized at compile time, Sequencer passes it no size
+template<typename R>
+struct IsFixedRingBuffer : std::false_type {};
+
+template<typename T,size_t N>
+struct IsFixedRingBuffer<FixedRingBuffer<T,N>> : std::true_type {};
+
+// c++11 needs a definition when the constants are bound to a reference
+template<typename T,size_t N>
+constexpr int64_t FixedRingBuffer<T,N>::kCapacity;
+template<typename T,size_t N>
+constexpr int64_t FixedRingBuffer<T,N>::kIndexMask;
+template<typename T,size_t N>
+constexpr bool FixedRingBuffer<T,N>::kInline;
+
+} // end namespace disruptor
+
+#endif
\ No newline at end of file
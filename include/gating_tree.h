@@ -0,0 +1,174 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_GATING_TREE_H_
+#define DISRUPTOR_GATING_TREE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <limits.h>
+
+#include "sequence.h"
+
+namespace disruptor {
+
+// number of children aggregated by one node of a gating tree
+constexpr size_t kDefaultGatingFanOut = 8;
+// parent of the root node
+constexpr size_t kNoGatingParent = SIZE_MAX;
+
+/**
+ * @brief A tree of minimum aggregator sequences over many consumer sequences.
+ * Each node holds the minimum of at most fan_out children, the consumers
+ * are the leaves and the root holds the minimum of all of them. Gating the
+ * producers on the root alone makes their wrap check read a single cache
+ * line whatever the number of consumers, the aggregation cost moves to the
+ * consumers: after publishing its sequence a consumer calls Update, which
+ * climbs O(log(consumers)) nodes reading fan_out siblings on each level.
+ * Usage:
+ *     GatingTree tree(consumer_sequences);
+ *     sequencer.SetGatingSequences({tree.GetRoot()});
+ *     processor.SetGatingTree(&tree,leaf_index);
+ * The leaves must outlive the tree and must only move forward, there must
+ * be at least one: gate on an empty SequenceGroup when there is no consumer.
+*/
+class GatingTree
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(GatingTree);
+public:
+    explicit GatingTree(const std::vector<Sequence*>& leaves,
+                        size_t fan_out = kDefaultGatingFanOut)
+        : _fan_out(std::max<size_t>(fan_out,2)),
+          _leaves(leaves) {
+        assert(!_leaves.empty());
+        // level by level from the leaves to the root, a single leaf(or
+        // none, whose root never gates) still gets a root node of its own
+        std::vector<size_t> level_begin;
+        size_t level_size = std::max<size_t>(_leaves.size(),1);
+        size_t node_count = 0;
+        do {
+            level_size = (level_size + _fan_out - 1) / _fan_out;
+            level_begin.push_back(node_count);
+            node_count += level_size;
+        } while(level_size > 1);
+
+        _nodes.reset(new Sequence[node_count]);
+        _node_count = node_count;
+        _parents.resize(node_count,kNoGatingParent);
+        _children.resize(node_count);
+
+        for(size_t i = 0; i < _leaves.size(); ++i) {
+            _children[i / _fan_out].push_back(_leaves[i]);
+        }
+        for(size_t level = 1; level < level_begin.size(); ++level) {
+            for(size_t node = level_begin[level - 1]; node < level_begin[level]; ++node) {
+                const size_t parent = level_begin[level] + (node - level_begin[level - 1]) / _fan_out;
+                _parents[node] = parent;
+                _children[parent].push_back(&_nodes[node]);
+            }
+        }
+
+        // the leaves may have moved before the tree is built
+        for(size_t node = 0; node < _node_count; ++node) {
+            _nodes[node].SetSequence(ReadMinimum(node));
+        }
+    }
+
+    // The sequence to gate the producers on
+    Sequence* GetRoot() {
+        return &_nodes[_node_count - 1];
+    }
+
+    size_t GetLeafCount() const {
+        return _leaves.size();
+    }
+
+    size_t GetDepth() const {
+        size_t depth = 1;
+        for(size_t node = 0; _parents[node] != kNoGatingParent; node = _parents[node]) {
+            ++depth;
+        }
+        return depth;
+    }
+
+    /**
+     * @brief Propagate a leaf which moved forward toward the root
+     * @param leaf_index index of the leaf in the vector the tree was built
+     * from, called by the thread owning the leaf after setting it
+    */
+    void Update(size_t leaf_index) {
+        size_t node = leaf_index / _fan_out;
+        while(node != kNoGatingParent) {
+            // Two consumers of a node may each miss the other one's store
+            // without it, and both leave the node behind
+            std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+            if(!Advance(_nodes[node],ReadMinimum(node))) {
+                // an other consumer stored this minimum, or a larger one,
+                // and carries it upward
+                return;
+            }
+            node = _parents[node];
+        }
+    }
+
+private:
+    int64_t ReadMinimum(size_t node) const {
+        int64_t minimum = LONG_MAX;
+        for(Sequence* child : _children[node]) {
+            minimum = std::min(minimum,child->GetSequence());
+        }
+        return minimum;
+    }
+
+    // Raise the node to minimum, a stale smaller minimum computed by a
+    // slower consumer never moves it back
+    static bool Advance(Sequence& node,int64_t minimum) {
+        // CompareAndSet is relaxed, the fence orders the children's reads
+        // before the store the producers acquire
+        std::atomic_thread_fence(std::memory_order::memory_order_release);
+        int64_t current = node.GetSequence();
+        while(current < minimum) {
+            if(node.CompareAndSet(current,minimum)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const size_t _fan_out;
+    const std::vector<Sequence*> _leaves;
+    std::unique_ptr<Sequence[]> _nodes;
+    size_t _node_count;
+    std::vector<size_t> _parents;
+    std::vector<std::vector<Sequence*>> _children;
+};
+
+} // end namespace disruptor
+
+#endif
\ No newline at end of file
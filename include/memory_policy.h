@@ -0,0 +1,222 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_MEMORY_POLICY_H_
+#define DISRUPTOR_MEMORY_POLICY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "utils.h"
+
+namespace disruptor {
+
+// Where the pages of a ring buffer or an available buffer come from
+enum HugePageOption
+{
+    // regular pages from the heap
+    kNoHugePages,
+    // an anonymous mapping advised with MADV_HUGEPAGE, the kernel backs it
+    // with transparent huge pages when it can
+    kTransparentHugePages,
+    // a MAP_HUGETLB mapping from the reserved huge page pool, falls back
+    // to transparent huge pages when the pool is empty
+    kHugeTlbPages
+};
+
+// the memory is not bound to a NUMA node
+constexpr int kAnyNumaNode = -1;
+// default huge page size on x86_64 and aarch64
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+/**
+ * @brief How the storage of a ring is allocated.
+ * Any policy other than the default maps the memory, binds it to
+ * numa_node before it is first touched and locks it in RAM if asked.
+ * Every step falls back silently, MemoryRegion reports what was obtained
+*/
+struct MemoryPolicy
+{
+    MemoryPolicy(HugePageOption huge_pages = kNoHugePages,
+                 int numa_node = kAnyNumaNode,
+                 bool lock = false)
+        : huge_pages(huge_pages),
+          numa_node(numa_node),
+          lock(lock) {}
+
+    bool IsDefault() const {
+        return huge_pages == kNoHugePages && numa_node == kAnyNumaNode && !lock;
+    }
+
+    HugePageOption huge_pages;
+    int numa_node;
+    // mlock the pages, which also faults them all in
+    bool lock;
+};
+
+/**
+ * @brief A block of memory allocated following a MemoryPolicy, freed on
+ * destruction. The memory is not initialized. Its address is a multiple
+ * of alignment, at most the page size: mappings start on a page and heap
+ * blocks are allocated larger and rounded up
+*/
+class MemoryRegion
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(MemoryRegion);
+public:
+    explicit MemoryRegion(size_t size,
+                          const MemoryPolicy& policy = MemoryPolicy(),
+                          size_t alignment = alignof(std::max_align_t))
+        : _address(nullptr),
+          _allocation(nullptr),
+          _size(size),
+          _mapped_size(0),
+          _huge_tlb(false),
+          _bound(false),
+          _locked(false) {
+#if defined(__linux__)
+        if(!policy.IsDefault()) {
+            Map(policy);
+        }
+#endif
+        if(_address == nullptr) {
+            // operator new only aligns to max_align_t
+            _allocation = ::operator new(size + alignment - 1);
+            const uintptr_t address = reinterpret_cast<uintptr_t>(_allocation);
+            _address = reinterpret_cast<void*>((address + alignment - 1) / alignment * alignment);
+        }
+    }
+
+    ~MemoryRegion() {
+#if defined(__linux__)
+        if(_mapped_size != 0) {
+            munmap(_address,_mapped_size);
+            return;
+        }
+#endif
+        ::operator delete(_allocation);
+    }
+
+    void* GetAddress() const {
+        return _address;
+    }
+
+    size_t GetSize() const {
+        return _size;
+    }
+
+    // the memory is an anonymous mapping rather than heap memory
+    bool IsMapped() const {
+        return _mapped_size != 0;
+    }
+
+    // the memory comes from the reserved huge page pool
+    bool IsHugeTlb() const {
+        return _huge_tlb;
+    }
+
+    // the memory is bound to the policy's NUMA node
+    bool IsBound() const {
+        return _bound;
+    }
+
+    // the memory is locked in RAM
+    bool IsLocked() const {
+        return _locked;
+    }
+
+private:
+#if defined(__linux__)
+    static size_t RoundUp(size_t size,size_t unit) {
+        return (size + unit - 1) / unit * unit;
+    }
+
+    void Map(const MemoryPolicy& policy) {
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        if(policy.huge_pages == kHugeTlbPages) {
+            const size_t size = RoundUp(_size,kHugePageSize);
+            void* address = mmap(nullptr,size,PROT_READ | PROT_WRITE,flags | MAP_HUGETLB,-1,0);
+            if(address != MAP_FAILED) {
+                _address = address;
+                _mapped_size = size;
+                _huge_tlb = true;
+            }
+        }
+        if(_address == nullptr) {
+            // whole huge pages give khugepaged something to collapse
+            const size_t size = policy.huge_pages == kNoHugePages ?
+                    RoundUp(_size,static_cast<size_t>(sysconf(_SC_PAGESIZE))) :
+                    RoundUp(_size,kHugePageSize);
+            void* address = mmap(nullptr,size,PROT_READ | PROT_WRITE,flags,-1,0);
+            if(address == MAP_FAILED) {
+                return;
+            }
+            _address = address;
+            _mapped_size = size;
+#if defined(MADV_HUGEPAGE)
+            if(policy.huge_pages != kNoHugePages) {
+                madvise(_address,_mapped_size,MADV_HUGEPAGE);
+            }
+#endif
+        }
+
+        // nothing touched the pages yet, they are placed on the node
+        // when first written
+#if defined(SYS_mbind)
+        if(policy.numa_node >= 0 && policy.numa_node < 64) {
+            // MPOL_BIND and MPOL_MF_MOVE, without depending on libnuma
+            const int mpol_bind = 2;
+            const unsigned mpol_mf_move = 1U << 1;
+            const unsigned long node_mask = 1UL << policy.numa_node;
+            _bound = syscall(SYS_mbind,_address,_mapped_size,mpol_bind,
+                             &node_mask,sizeof(node_mask) * 8,mpol_mf_move) == 0;
+        }
+#endif
+        if(policy.lock) {
+            _locked = mlock(_address,_mapped_size) == 0;
+        }
+    }
+#endif
+
+    void* _address;
+    // the heap block holding _address, null when mapped
+    void* _allocation;
+    size_t _size;
+    size_t _mapped_size;
+    bool _huge_tlb;
+    bool _bound;
+    bool _locked;
+};
+
+} // end namespace disruptor
+
+#endif
\ No newline at end of file
@@ -0,0 +1,225 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_PRODUCER_WAIT_STRATEGY_H_
+#define DISRUPTOR_PRODUCER_WAIT_STRATEGY_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "sequence.h"
+#include "sequence_group.h"
+#include "utils.h"
+
+namespace disruptor {
+
+// Strategy options for the producers waiting for the consumers to free
+// the ring buffer
+enum ProducerWaitStrategyOption {
+    // Call yield() in a loop
+    kYieldingProducerWait,
+    // Spin with a cpu pause, lowest latency but ties up a CPU
+    kBusySpinProducerWait,
+    // Spin, then sleep for a duration doubled on every retry up to a limit,
+    // gives the CPU back on shared hosts
+    kSleepingProducerWait,
+    // Block on a condition variable, the consumers signal the producers
+    // when they advance their sequence
+    kBlockingProducerWait
+};
+
+constexpr int64_t kDefaultProducerSpinLoops = 100L;
+constexpr int64_t kDefaultProducerMaxSleepMicros = 1000L;
+
+// Interface of the strategies used by the claim strategies while the wrap
+// point is ahead of the gating sequences. Only called on a full ring buffer
+class ProducerWaitStrategy
+{
+public:
+    virtual ~ProducerWaitStrategy() {}
+
+    /**
+     * @brief Wait for the gating sequences to reach the wrap point
+     * @param wrap_point sequence the slowest consumer has to reach
+     * @param dependents gating sequences of the consumers
+     * @return minimum of the gating sequences, at least wrap_point
+    */
+    virtual int64_t WaitFor(int64_t wrap_point,
+                            const SequenceGroup& dependents) = 0;
+
+    /**
+     * @brief Signal the strategy that a consumer advanced its sequence,
+     * only the blocking strategy does anything
+    */
+    virtual void SignalAllWhenBlocking() = 0;
+};
+
+class YieldingProducerWaitStrategy final : public ProducerWaitStrategy
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(YieldingProducerWaitStrategy);
+public:
+    YieldingProducerWaitStrategy() {}
+
+    virtual int64_t WaitFor(int64_t wrap_point,
+                            const SequenceGroup& dependents) override {
+        int64_t min_sequence;
+        while(wrap_point > (min_sequence = dependents.GetMinimumSequence(wrap_point))) {
+            std::this_thread::yield();
+        }
+        return min_sequence;
+    }
+
+    virtual void SignalAllWhenBlocking() override {}
+};
+
+class BusySpinProducerWaitStrategy final : public ProducerWaitStrategy
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(BusySpinProducerWaitStrategy);
+public:
+    BusySpinProducerWaitStrategy() {}
+
+    virtual int64_t WaitFor(int64_t wrap_point,
+                            const SequenceGroup& dependents) override {
+        int64_t min_sequence;
+        while(wrap_point > (min_sequence = dependents.GetMinimumSequence(wrap_point))) {
+            util::CpuPause();
+        }
+        return min_sequence;
+    }
+
+    virtual void SignalAllWhenBlocking() override {}
+};
+
+class SleepingProducerWaitStrategy final : public ProducerWaitStrategy
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(SleepingProducerWaitStrategy);
+public:
+    explicit SleepingProducerWaitStrategy(int64_t spin_loops = kDefaultProducerSpinLoops,
+                                          int64_t max_sleep_micros = kDefaultProducerMaxSleepMicros)
+        : _spin_loops(spin_loops),
+          _max_sleep_micros(max_sleep_micros) {}
+
+    virtual int64_t WaitFor(int64_t wrap_point,
+                            const SequenceGroup& dependents) override {
+        int64_t min_sequence;
+        int64_t counter = _spin_loops;
+        int64_t sleep_micros = 1L;
+        while(wrap_point > (min_sequence = dependents.GetMinimumSequence(wrap_point))) {
+            if(counter > 0) {
+                --counter;
+                util::CpuPause();
+            }
+            else {
+                std::this_thread::sleep_for(std::chrono::microseconds(sleep_micros));
+                sleep_micros = std::min(sleep_micros * 2L,_max_sleep_micros);
+            }
+        }
+        return min_sequence;
+    }
+
+    virtual void SignalAllWhenBlocking() override {}
+
+private:
+    int64_t _spin_loops;
+    int64_t _max_sleep_micros;
+};
+
+// Producers block until a consumer signals. The consumers only take the
+// lock when a producer is waiting, so signalling is a load on the fast path
+class BlockingProducerWaitStrategy final : public ProducerWaitStrategy
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(BlockingProducerWaitStrategy);
+    using Lock = std::unique_lock<std::mutex>;
+public:
+    BlockingProducerWaitStrategy() : _waiters(0) {}
+
+    virtual int64_t WaitFor(int64_t wrap_point,
+                            const SequenceGroup& dependents) override {
+        int64_t min_sequence;
+        if(wrap_point <= (min_sequence = dependents.GetMinimumSequence(wrap_point))) {
+            return min_sequence;
+        }
+        Lock ulock(_mutex);
+        _waiters.fetch_add(1);
+        // pairs with the fence of SignalAllWhenBlocking: either the consumer
+        // sees the waiter or the producer sees the advanced sequence
+        std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+        while(wrap_point > (min_sequence = dependents.GetMinimumSequence(wrap_point))) {
+            _producer_notify_condition.wait(ulock);
+        }
+        _waiters.fetch_sub(1);
+        return min_sequence;
+    }
+
+    virtual void SignalAllWhenBlocking() override {
+        std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+        if(_waiters.load(std::memory_order::memory_order_relaxed) > 0) {
+            Lock ulock(_mutex);
+            _producer_notify_condition.notify_all();
+        }
+    }
+
+private:
+    std::atomic<int64_t> _waiters;
+    std::mutex _mutex;
+    std::condition_variable _producer_notify_condition;
+};
+
+static inline ProducerWaitStrategy* CreateProducerWaitStrategy(ProducerWaitStrategyOption option) {
+    ProducerWaitStrategy* strategy = nullptr;
+    switch (option) {
+    case kYieldingProducerWait:
+        strategy = new YieldingProducerWaitStrategy();
+        break;
+    case kBusySpinProducerWait:
+        strategy = new BusySpinProducerWaitStrategy();
+        break;
+    case kSleepingProducerWait:
+        strategy = new SleepingProducerWaitStrategy();
+        break;
+    case kBlockingProducerWait:
+        strategy = new BlockingProducerWaitStrategy();
+        break;
+    default:
+        break;
+    }
+    return strategy;
+}
+
+// Used by the claim strategies built without a producer wait strategy,
+// yielding as they always did
+static inline ProducerWaitStrategy* DefaultProducerWaitStrategy() {
+    static YieldingProducerWaitStrategy strategy;
+    return &strategy;
+}
+
+} // end namespace disruptor
+
+#endif
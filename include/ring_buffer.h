@@ -26,28 +26,144 @@
 #ifndef DISRUPTOR_RING_BUFFER_H_
 #define DISRUPTOR_RING_BUFFER_H_
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
 #include <utils.h>
+#include "memory_policy.h"
+#include "sequence.h"
+#include "slot_span.h"
 
 namespace disruptor {
 constexpr size_t kDefaultRingBufferSize = 1024;
 
+// How the events are laid out in the RingBuffer
+enum SlotLayoutOption
+{
+    // slots back to back, sizeof(T) bytes per slot. Small events of
+    // neighbour sequences share a cache line, so the producer writing
+    // slot N invalidates the line the consumer reads slot N-1 from
+    kPackedSlotLayout,
+    // every slot starts its own false sharing range
+    kPaddedSlotLayout,
+    // slots_per_group(rounded down to a power of 2) slots share a false
+    // sharing range, trading memory against the producer and the consumer
+    // sharing a line only within a group
+    kGroupedSlotLayout
+};
+
+constexpr int64_t kDefaultSlotsPerGroup = 2;
+
+// How the events are constructed when the RingBuffer is built
+enum SlotInitOption
+{
+    // constructed one after the other by the constructing thread
+    kSerialSlotInit,
+    // constructed by several threads, each faulting in the pages of its
+    // own range, so the ring is ready and resident when built
+    kParallelSlotInit,
+    // not constructed nor touched, the pages fault in on the first lap.
+    // Only for trivially default constructible and destructible events,
+    // the slots hold zeros on mapped memory(see MemoryPolicy) and
+    // indeterminate values on the heap. Other events, or a factory, fall
+    // back to kSerialSlotInit
+    kLazySlotInit
+};
+
+// The events kLazySlotInit leaves unconstructed: the ring buffers destroy
+// every slot, so the destructor has to be trivial too
+template<typename T>
+struct IsLazySlotInitSupported
+    : std::integral_constant<bool,std::is_trivially_default_constructible<T>::value &&
+                                  std::is_trivially_destructible<T>::value> {};
+
+// below this number of slots a thread is not worth starting
+constexpr int64_t kMinSlotsPerInitThread = 64 * 1024;
+
+/**
+ * @brief Constructs the events of a RingBuffer in place, e.g. to allocate
+ * their payload once at startup. Called from several threads at once with
+ * kParallelSlotInit
+*/
+template<typename T>
+class EventFactory
+{
+public:
+    virtual ~EventFactory() = default;
+
+    // Construct the event of the slot index in memory and return it
+    virtual T* NewInstance(const int64_t& index,void* memory) = 0;
+};
+
+// How the events of a RingBuffer are constructed, threads 0 uses every
+// hardware thread, a null factory default constructs the events
+template<typename T>
+struct SlotInitPolicy
+{
+    SlotInitPolicy(SlotInitOption option = kSerialSlotInit,
+                   size_t threads = 0,
+                   EventFactory<T>* factory = nullptr)
+        : option(option),
+          threads(threads),
+          factory(factory) {}
+
+    SlotInitOption option;
+    size_t threads;
+    EventFactory<T>* factory;
+};
+
 /**
  * @brief RingBuffer implemented with a fixed array
  * @param T EventType
+ * The slots are grouped, a group holds 1 << _group_shift slots and starts
+ * _group_stride bytes after the previous one. The packed layout is a single
+ * slot group of sizeof(T) bytes
  */
 template <typename T>
 class RingBuffer
 {
     DISALLOW_COPY_MOVE_AND_ASSIGN(RingBuffer);
 public:
-    explicit RingBuffer(int64_t size) : _size(size), _events(new T[size]) {
+    explicit RingBuffer(int64_t size,
+                        SlotLayoutOption layout = kPackedSlotLayout,
+                        int64_t slots_per_group = kDefaultSlotsPerGroup,
+                        const MemoryPolicy& memory_policy = MemoryPolicy(),
+                        const SlotInitPolicy<T>& slot_init = SlotInitPolicy<T>())
+        : _size(size),
+          _layout(layout),
+          _group_shift(0),
+          _group_mask(0),
+          _group_stride(sizeof(T)) {
         // assert(((size > 0) && ((size & (~size + 1)) == size)),
         //             "RingBuffer's size must be a positive power of 2");
+        if(layout == kPaddedSlotLayout) {
+            _group_stride = RoundUpToRange(sizeof(T));
+        }
+        else if(layout == kGroupedSlotLayout) {
+            while((int64_t(2) << _group_shift) <= slots_per_group) {
+                ++_group_shift;
+            }
+            _group_mask = (int64_t(1) << _group_shift) - 1;
+            _group_stride = RoundUpToRange(sizeof(T) << _group_shift);
+        }
+
+        // the first group starts a false sharing range
+        _memory.reset(new MemoryRegion(MemorySize() + FALSE_SHARING_RANGE_IN_BYTES,memory_policy));
+        char* memory = static_cast<char*>(_memory->GetAddress());
+        const uintptr_t address = reinterpret_cast<uintptr_t>(memory);
+        _events = memory + (FALSE_SHARING_RANGE_IN_BYTES - address % FALSE_SHARING_RANGE_IN_BYTES);
+        InitSlots(slot_init);
     }
 
     ~RingBuffer() {
-        delete []_events;
+        for(int64_t i = 0; i < _size; ++i) {
+            Slot(i)->~T();
+        }
         _events = nullptr;
     }
 
@@ -57,12 +173,105 @@ public:
      * @return event referenced at the specified sequence position
      */
     T* operator[](const int64_t& sequence) { 
-        return &_events[sequence & (_size - 1)]; 
+        // the default packed layout indexes an array, as without layouts:
+        // the layout test is the same branch on every access
+        if(_layout == kPackedSlotLayout) {
+            return reinterpret_cast<T*>(_events) + (sequence & (_size - 1));
+        }
+        return Slot(sequence & (_size - 1)); 
+    }
+
+    // Number of events in the RingBuffer
+    int64_t GetSize() const {
+        return _size;
+    }
+
+    /**
+     * @brief Get the slots of up to count sequences from sequence on which
+     * are contiguous: up to the end of the ring with the packed layout, of
+     * the group with the grouped layout and a single slot when padded(unless
+     * the slots fill their false sharing ranges, see SlotAddressing)
+    */
+    SlotSpan<T> GetSpan(int64_t sequence,int64_t count) const {
+        return GetSlotAddressing().GetSpan(sequence,count);
+    }
+
+    // Where the slots are, for any slot layout
+    SlotAddressing<T> GetSlotAddressing() const {
+        return SlotAddressing<T>(_events,_size,_group_shift,_group_stride);
+    }
+
+    SlotLayoutOption GetSlotLayout() const {
+        return _layout;
+    }
+
+    // How the slots were allocated
+    const MemoryRegion& GetMemoryRegion() const {
+        return *_memory;
+    }
+
+    // Bytes used by the slots
+    size_t MemorySize() const {
+        return ((_size + _group_mask) >> _group_shift) * _group_stride;
     }
 
 private:
+    void InitSlots(const SlotInitPolicy<T>& slot_init) {
+        if(slot_init.option == kLazySlotInit &&
+                slot_init.factory == nullptr &&
+                IsLazySlotInitSupported<T>::value) {
+            return;
+        }
+        size_t threads = 1;
+        if(slot_init.option == kParallelSlotInit) {
+            threads = slot_init.threads != 0 ? slot_init.threads : std::thread::hardware_concurrency();
+            threads = std::min<size_t>(threads,(_size + kMinSlotsPerInitThread - 1) / kMinSlotsPerInitThread);
+            threads = std::max<size_t>(threads,1);
+        }
+        // contiguous ranges so each thread faults in its own pages
+        const int64_t slots_per_thread = (_size + threads - 1) / threads;
+        std::vector<std::thread> workers;
+        for(size_t t = 1; t < threads; ++t) {
+            const int64_t begin = t * slots_per_thread;
+            const int64_t end = std::min(_size,begin + slots_per_thread);
+            workers.emplace_back([this,&slot_init,begin,end](){
+                ConstructSlots(slot_init.factory,begin,end);
+            });
+        }
+        ConstructSlots(slot_init.factory,0,std::min(_size,slots_per_thread));
+        for(auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void ConstructSlots(EventFactory<T>* factory,int64_t begin,int64_t end) {
+        for(int64_t i = begin; i < end; ++i) {
+            if(factory != nullptr) {
+                factory->NewInstance(i,Slot(i));
+            }
+            else {
+                new (Slot(i)) T();
+            }
+        }
+    }
+
+    static size_t RoundUpToRange(size_t bytes) {
+        return (bytes + FALSE_SHARING_RANGE_IN_BYTES - 1) / FALSE_SHARING_RANGE_IN_BYTES
+                    * FALSE_SHARING_RANGE_IN_BYTES;
+    }
+
+    inline T* Slot(int64_t index) const {
+        return reinterpret_cast<T*>(_events + (index >> _group_shift) * _group_stride
+                                            + (index & _group_mask) * sizeof(T));
+    }
+
     int64_t _size;
-    T* _events;
+    SlotLayoutOption _layout;
+    int64_t _group_shift;
+    int64_t _group_mask;
+    size_t _group_stride;
+    std::unique_ptr<MemoryRegion> _memory;
+    char* _events;
 };
 
 }
@@ -30,9 +30,20 @@
 #define CACHE_LINE_SIZE_IN_BYTES 64
 #endif
 
+// bytes kept free on each side of a hot atomic, 128 also keeps it away
+// from the line the adjacent line prefetcher pulls in with its own
+// (PREFETCH_PAIR option)
+#ifndef FALSE_SHARING_RANGE_IN_BYTES
+#define FALSE_SHARING_RANGE_IN_BYTES CACHE_LINE_SIZE_IN_BYTES
+#endif
+
 // for atomic param cache line padding 7
 #define ATOMIC_SEQUENCE_PADDING_LENGTH \
-    (CACHE_LINE_SIZE_IN_BYTES - sizeof(std::atomic<int64_t>)) / 8
+    (FALSE_SHARING_RANGE_IN_BYTES - sizeof(std::atomic<int64_t>)) / 8
+
+// int64_t padding separating members written by different threads
+#define CACHE_LINE_PADDING_LENGTH \
+    FALSE_SHARING_RANGE_IN_BYTES / 8
 
 #include <atomic>
 #include <vector>
@@ -45,6 +56,8 @@ namespace disruptor {
 constexpr int64_t kInitialCursorValue = -1L;
 constexpr int64_t kAlertedSignal = -2L;
 constexpr int64_t kTimeoutSignal = -3L;
+// a try claim found the ring buffer full
+constexpr int64_t kInsufficientCapacitySignal = -4L;
 constexpr int64_t kFirstSequenceValue = kInitialCursorValue + 1L;
 
 class Sequence
@@ -78,12 +91,14 @@ public:
         return _sequence.compare_exchange_strong(expected,next,std::memory_order::memory_order_relaxed);
     }
 private:
-    // padding make sure the _sequece won't appear with other param
+    // padding on both sides make sure the _sequece won't appear with
+    // other param whatever the alignment of the Sequence, alignas is not
+    // used as c++11 new does not honour it
     int64_t _padding0[ATOMIC_SEQUENCE_PADDING_LENGTH];
     // member
     std::atomic<int64_t> _sequence;
-    // // padding
-    // int64_t _padding1[ATOMIC_SEQUENCE_PADDING_LENGTH];
+    // padding
+    int64_t _padding1[ATOMIC_SEQUENCE_PADDING_LENGTH];
 };
 
 inline int64_t GetMinimumSequence(const std::vector<Sequence*>& sequences) 
@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "sequence.h"
+#include "sequence_group.h"
 #include "wait_strategy.h"
 #include "claim_strategy.h"
 
@@ -37,15 +38,18 @@ namespace disruptor {
 
 /**
  * @brief Used for consumer to wait for the target sequence
+ * @param C ClaimStrategy interface or a concrete claim strategy
+ * @param W WaitStrategy interface or a concrete wait strategy
  * @example int64_t available_sequence = SequenceBarrier.WaitFor(next_sequence);
 */
-class SequenceBarrier
+template<typename C,typename W>
+class BasicSequenceBarrier
 {
 public:
-    explicit SequenceBarrier(const Sequence& cursor,
-                             const std::vector<Sequence*>& dependents,
-                             WaitStrategy* wait_strategy,
-                             ClaimStrategy* claim_strategy)
+    explicit BasicSequenceBarrier(const Sequence& cursor,
+                                  const SequenceGroup& dependents,
+                                  W* wait_strategy,
+                                  C* claim_strategy)
         : _cursor(cursor),
           _dependents(dependents),
           _wait_strategy(wait_strategy),
@@ -56,7 +60,8 @@ public:
      * @brief Return the maximum accessible serial number of RingBuffer
     */
     inline int64_t WaitFor(const int64_t& sequence) {
-        int64_t available_sequence = _wait_strategy->WaitFor(sequence,_cursor,_dependents,_alerted);
+        int64_t available_sequence = _wait_strategy->BarrierWaitFor(sequence,_cursor,_dependents,
+                                                                    _alerted,_wait_state);
         if(available_sequence < kFirstSequenceValue) {
             return available_sequence;
         }
@@ -67,13 +72,34 @@ public:
 
     inline int64_t WaitFor(const int64_t& sequence,
                            const std::chrono::microseconds& timeout) {
-        int64_t available_sequence = _wait_strategy->WaitFor(sequence,_cursor,_dependents,_alerted,timeout);
+        int64_t available_sequence = _wait_strategy->BarrierWaitFor(sequence,_cursor,_dependents,
+                                                                    _alerted,timeout,_wait_state);
         if(available_sequence < kFirstSequenceValue) {
             return available_sequence;
         }
         return _claim_strategy->GetHighesetPublishedSequence(sequence,available_sequence);
     }
 
+    /**
+     * @brief Return without waiting, for consumers polling from their own
+     * event loop
+     * @return the highest sequence available to read, lower than sequence
+     * when there is no new event, kAlertedSignal if the barrier is alerted
+    */
+    inline int64_t Poll(const int64_t& sequence) {
+        if(Alerted()) {
+            return kAlertedSignal;
+        }
+        int64_t available_sequence = _cursor.GetSequence();
+        if(available_sequence >= sequence && !_dependents.empty()) {
+            available_sequence = _dependents.GetMinimumSequence(sequence);
+        }
+        if(available_sequence < sequence) {
+            return available_sequence;
+        }
+        return _claim_strategy->GetHighesetPublishedSequence(sequence,available_sequence);
+    }
+
     inline int64_t GetSequence() {
         return _cursor.GetSequence();
     }
@@ -88,23 +114,40 @@ public:
 
     /**
      * @brief special used for wake up blocking wait_strategy
+     * also wakes the strategies parked on the dependents, for an alert
     */
     inline void SignalAllWhenBlocking() {
         _wait_strategy->SignalAllWhenBlocking();
+        for(Sequence* dependent : _dependents) {
+            _wait_strategy->SignalWhenBlocking(*dependent);
+        }
+    }
+
+    /**
+     * @brief Used by the event processor after advancing its sequence to
+     * wake the downstream processors parked on it
+    */
+    inline void SignalWhenBlocking(const Sequence& sequence) {
+        _wait_strategy->SignalWhenBlocking(sequence);
     }
 private:
     // producer
     const Sequence& _cursor;
     // current consumer(which use this barrier) dependents's condition
-    std::vector<Sequence*> _dependents;
+    SequenceGroup _dependents;
     // strategy decide how it will wait for this available sequence
-    WaitStrategy* _wait_strategy;
+    W* _wait_strategy;
     // strategy decide how it get published sequence
-    ClaimStrategy* _claim_strategy;
+    C* _claim_strategy;
     // alerted
     std::atomic<bool> _alerted;
+    // kept by the wait strategy between the waits of the consumer
+    WaitState _wait_state;
 };
 
+// Barrier dispatching through the runtime strategy interfaces
+using SequenceBarrier = BasicSequenceBarrier<ClaimStrategy,WaitStrategy>;
+
 } // end namespace disruptor
 
 #endif
\ No newline at end of file
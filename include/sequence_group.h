@@ -0,0 +1,237 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_SEQUENCE_GROUP_H_
+#define DISRUPTOR_SEQUENCE_GROUP_H_
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <limits.h>
+
+#include "sequence.h"
+
+namespace disruptor {
+
+// groups up to this size are stored inline
+constexpr size_t kSequenceGroupInlineSize = 4;
+
+/**
+ * @brief Sequences gating a consumer(its dependents) or the producers(the
+ * gating sequences) with a cached minimum.
+ * Sequences only move forward, so a minimum read once stays a lower bound:
+ * GetMinimumSequence(required) returns the cached minimum while it is at
+ * least required, and only reads every sequence again when it is not.
+ * A wait loop therefore reads the other cores' sequences only when the
+ * last minimum is used up. Small groups are stored inline.
+ * A group can forward to another one(see Forward), whose sequences are
+ * replaced while producers wait on the group. It then reads as the group
+ * it forwards to: size() and the iteration are those of the current set.
+*/
+class SequenceGroup
+{
+public:
+    SequenceGroup()
+        : _size(0),
+          _cached_minimum(kInitialCursorValue),
+          _forward(nullptr),
+          _epoch(0) {
+        _readers[0].store(0);
+        _readers[1].store(0);
+    }
+
+    // implicit, a vector of sequences can be passed where a group is expected
+    SequenceGroup(const std::vector<Sequence*>& sequences) : SequenceGroup() {
+        Assign(sequences.data(),sequences.size());
+    }
+
+    SequenceGroup(const SequenceGroup& other) : SequenceGroup() {
+        Assign(other.data(),other.size());
+    }
+
+    SequenceGroup& operator=(const SequenceGroup& other) {
+        if(this != &other) {
+            Assign(other.data(),other.size());
+        }
+        return *this;
+    }
+
+    // The sequences of a forwarding group are those of the group it
+    // forwards to, valid until that one is replaced
+    size_t size() const {
+        return Current()._size;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    Sequence* const* data() const {
+        return Current().OwnData();
+    }
+
+    Sequence* const* begin() const {
+        return data();
+    }
+
+    Sequence* const* end() const {
+        const SequenceGroup& current = Current();
+        return current.OwnData() + current._size;
+    }
+
+    Sequence* operator[](size_t index) const {
+        return data()[index];
+    }
+
+    /**
+     * @brief Minimum of the sequences
+     * @param required the caller only needs to know whether the minimum
+     * reached it, a cached minimum at least required is returned as is.
+     * An empty group bounds nothing yet, required is returned for it so
+     * the callers never cache a bound the sequences added later miss
+    */
+    inline int64_t GetMinimumSequence(int64_t required) const {
+        // acquire: a producer using a minimum another producer read sees
+        // the consumers' release of the slots up to it
+        const int64_t cached = _cached_minimum.load(std::memory_order::memory_order_acquire);
+        if(cached >= required) {
+            return cached;
+        }
+        const int64_t minimum = GetMinimumSequence();
+        return minimum == LONG_MAX ? required : minimum;
+    }
+
+    // Read every sequence and refresh the cached minimum, LONG_MAX for an
+    // empty group, which caches nothing
+    inline int64_t GetMinimumSequence() const {
+        if(_forward.load(std::memory_order::memory_order_relaxed) == nullptr) {
+            const int64_t minimum = ReadMinimum();
+            CacheMinimum(minimum);
+            return minimum;
+        }
+        // registered in the counter of the current epoch, so Forward()
+        // knows when the previous group is no longer read
+        int64_t epoch = _epoch.load();
+        _readers[epoch & 1].fetch_add(1);
+        while(_epoch.load() != epoch) {
+            _readers[epoch & 1].fetch_sub(1);
+            epoch = _epoch.load();
+            _readers[epoch & 1].fetch_add(1);
+        }
+        const int64_t minimum = _forward.load()->ReadMinimum();
+        // cached while registered and only if the group was not replaced
+        // meanwhile: Forward() clears the cache once the readers of the
+        // previous group left, no minimum of it is cached afterwards
+        if(_epoch.load() == epoch) {
+            CacheMinimum(minimum);
+        }
+        _readers[epoch & 1].fetch_sub(1,std::memory_order::memory_order_release);
+        return minimum;
+    }
+
+    /**
+     * @brief Read the minimum of sequences from now on, instead of the
+     * group's own or those of the previous call. A wait loop on the group
+     * reads the new sequences on its next retry. Calls must be serialized
+     * and made before the group is shared.
+     * @return the previous group, or null. Forward returns once no
+     * minimum is read from it, so it can be freed
+    */
+    SequenceGroup* Forward(SequenceGroup* sequences) {
+        SequenceGroup* previous = _forward.exchange(sequences);
+        if(previous != nullptr) {
+            // readers of the new epoch read the new group, the readers of
+            // the previous one are at most a scan each
+            const int64_t epoch = _epoch.fetch_add(1) & 1;
+            while(_readers[epoch].load() != 0) {
+                std::this_thread::yield();
+            }
+        }
+        // after the drain, a reader of the previous group may have cached
+        // its minimum until then
+        _cached_minimum.store(kInitialCursorValue,std::memory_order::memory_order_release);
+        return previous;
+    }
+
+    // The group Forward() was last called with, null if none
+    SequenceGroup* GetForward() const {
+        return _forward.load(std::memory_order::memory_order_acquire);
+    }
+
+private:
+    inline void CacheMinimum(int64_t minimum) const {
+        // an empty group caches nothing, see GetMinimumSequence(required)
+        if(minimum != LONG_MAX) {
+            _cached_minimum.store(minimum,std::memory_order::memory_order_release);
+        }
+    }
+
+    inline const SequenceGroup& Current() const {
+        const SequenceGroup* forward = _forward.load(std::memory_order::memory_order_acquire);
+        return forward == nullptr ? *this : *forward;
+    }
+
+    inline Sequence* const* OwnData() const {
+        return _size <= kSequenceGroupInlineSize ? _inline : _overflow.data();
+    }
+
+    inline int64_t ReadMinimum() const {
+        int64_t minimum = LONG_MAX;
+        Sequence* const* sequences = OwnData();
+        for(size_t i = 0; i < _size; ++i) {
+            minimum = std::min(minimum,sequences[i]->GetSequence());
+        }
+        return minimum;
+    }
+
+    void Assign(Sequence* const* sequences,size_t size) {
+        _size = size;
+        if(size <= kSequenceGroupInlineSize) {
+            std::copy(sequences,sequences + size,_inline);
+            _overflow.clear();
+        }
+        else {
+            _overflow.assign(sequences,sequences + size);
+        }
+        _cached_minimum.store(kInitialCursorValue,std::memory_order::memory_order_relaxed);
+    }
+
+    size_t _size;
+    Sequence* _inline[kSequenceGroupInlineSize];
+    std::vector<Sequence*> _overflow;
+    // shared by the producers of a multi thread claim strategy, any value
+    // stored is a lower bound of the current minimum. A minimum is stored
+    // with release after the acquire loads of the sequences, so the
+    // consumers' releases happen before any use of the cached value
+    mutable std::atomic<int64_t> _cached_minimum;
+    std::atomic<SequenceGroup*> _forward;
+    std::atomic<int64_t> _epoch;
+    mutable std::atomic<int64_t> _readers[2];
+};
+
+} // end namespace disruptor
+
+#endif
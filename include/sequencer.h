@@ -26,8 +26,17 @@
 #ifndef DISRUPTOR_SEQUENCER_H_
 #define DISRUPTOR_SEQUENCER_H_
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
 #include "ring_buffer.h"
+#include "fixed_ring_buffer.h"
 #include "sequence.h"
+#include "sequence_group.h"
+#include "slot_span.h"
 #include "claim_strategy.h"
 #include "wait_strategy.h"
 #include "sequence_barrier.h"
@@ -38,25 +47,140 @@ namespace disruptor {
  *      int64_t sequence = Next();
  *      Sequencer[sequence].value = user_setting_value;
  *      Publish();
+ * @param T EventType
+ * @param C claim strategy policy, ClaimStrategy selects it at runtime
+ * @param W wait strategy policy, WaitStrategy selects it at runtime
+ * @param R ring buffer, RingBuffer sizes it at runtime and FixedRingBuffer
+ *      at compile time(see FixedSequencer)
+ * @example Sequencer<Event,SingleThreadStrategy,BusySpinStrategy> calls
+ *      its strategies without virtual dispatch
 */
-template<typename T>
+template<typename T,
+         typename C = ClaimStrategy,
+         typename W = WaitStrategy,
+         typename R = RingBuffer<T>>
 class Sequencer
 {
     DISALLOW_COPY_MOVE_AND_ASSIGN(Sequencer);
 public:
+    using EventType = T;
+    using Barrier = BasicSequenceBarrier<C,W>;
+
     // Construct a Sequencer with the selected strategies
+    // the claim and wait options are only used by the runtime strategy
+    // interfaces, the available option by the multi thread strategies
+    // the producer wait option selects how producers wait on a full ring buffer
+    // the slot layout how the events are laid out in the ring buffer
+    // the memory policy how the ring buffer and the available buffer are
+    // allocated(huge pages, NUMA node, locked)
+    // the slot init how and by how many threads the events are constructed
+    template<typename Ring = R,
+             typename std::enable_if<!IsFixedRingBuffer<Ring>::value,int>::type = 0>
     explicit Sequencer(int64_t buffer_size = kDefaultRingBufferSize,
                        ClaimStrategyOption claim_option = kSingleThreadClaimStrategy,
-                       WaitStrategyOption wait_option = kBusySpinStrategy) 
-        : _ring_buffer(buffer_size),
-          _claim_strategy(CreateClaimStrategy(claim_option,buffer_size,_cursor)),
-          _wait_strategy(CreateWaitStrategy(wait_option)) {}
+                       WaitStrategyOption wait_option = kBusySpinStrategy,
+                       AvailableBufferOption available_option = kWideAvailableBuffer,
+                       ProducerWaitStrategyOption producer_wait_option = kYieldingProducerWait,
+                       SlotLayoutOption slot_layout = kPackedSlotLayout,
+                       int64_t slots_per_group = kDefaultSlotsPerGroup,
+                       const MemoryPolicy& memory_policy = MemoryPolicy(),
+                       const SlotInitPolicy<T>& slot_init = SlotInitPolicy<T>()) 
+        : _ring_buffer(buffer_size,slot_layout,slots_per_group,memory_policy,slot_init),
+          _producer_wait_strategy(CreateProducerWaitStrategy(producer_wait_option)),
+          _claim_strategy(ClaimStrategyBuilder<C>::Build(claim_option,_ring_buffer.GetSize(),
+                                                         _cursor,available_option,
+                                                         _producer_wait_strategy,
+                                                         memory_policy)),
+          _wait_strategy(WaitStrategyBuilder<W>::Build(wait_option)) {
+        _gating_sequences.Forward(new SequenceGroup());
+    }
+
+    // Construct a Sequencer over a FixedRingBuffer, it takes the same
+    // options but the buffer size, which is the ring buffer's capacity,
+    // and the slot layout, which is packed
+    template<typename Ring = R,
+             typename std::enable_if<IsFixedRingBuffer<Ring>::value,int>::type = 0>
+    explicit Sequencer(ClaimStrategyOption claim_option = kSingleThreadClaimStrategy,
+                       WaitStrategyOption wait_option = kBusySpinStrategy,
+                       AvailableBufferOption available_option = kWideAvailableBuffer,
+                       ProducerWaitStrategyOption producer_wait_option = kYieldingProducerWait,
+                       const MemoryPolicy& memory_policy = MemoryPolicy(),
+                       const SlotInitPolicy<T>& slot_init = SlotInitPolicy<T>())
+        : _ring_buffer(memory_policy,slot_init),
+          _producer_wait_strategy(CreateProducerWaitStrategy(producer_wait_option)),
+          _claim_strategy(ClaimStrategyBuilder<C>::Build(claim_option,_ring_buffer.GetSize(),
+                                                         _cursor,available_option,
+                                                         _producer_wait_strategy,
+                                                         memory_policy)),
+          _wait_strategy(WaitStrategyBuilder<W>::Build(wait_option)) {
+        _gating_sequences.Forward(new SequenceGroup());
+    }
+
+    ~Sequencer() {
+        delete _gating_sequences.GetForward();
+    }
 
     // Set the sequences(consumers) that will gate producers to prevent
     // the ring buffer wrapping
     // sequences are the last level consumers in the processing
-    void SetGatingSequences(const std::vector<Sequence*>& sequences) {
-        _gating_sequences = sequences;
+    void SetGatingSequences(const SequenceGroup& sequences) {
+        std::lock_guard<std::mutex> lock(_gating_mutex);
+        SwapGatingSequences(new SequenceGroup(sequences));
+    }
+
+    /**
+     * @brief Gate the producers on more consumers while they are running.
+     * The sequences are moved to the cursor first, so a processor which is
+     * not running yet starts with the next published event.
+     * The gating sequences are copied on write: the producers read their
+     * minimum through a group forwarding to the current set, which is
+     * freed once replaced and no longer read
+    */
+    void AddGatingSequences(const std::vector<Sequence*>& sequences) {
+        std::lock_guard<std::mutex> lock(_gating_mutex);
+        const SequenceGroup* current = _gating_sequences.GetForward();
+        std::vector<Sequence*> updated(current->begin(),current->end());
+        int64_t cursor = _cursor.GetSequence();
+        for(Sequence* sequence : sequences) {
+            sequence->SetSequence(cursor);
+            updated.push_back(sequence);
+        }
+        SwapGatingSequences(new SequenceGroup(updated));
+
+        // the cursor may have moved before the producers saw the new
+        // sequences, none of them may gate behind it
+        cursor = _cursor.GetSequence();
+        for(Sequence* sequence : sequences) {
+            sequence->SetSequence(cursor);
+        }
+    }
+
+    /**
+     * @brief Stop gating the producers on the sequences while they are
+     * running, e.g. after stopping their processors. A producer waiting on
+     * a full ring reads the remaining sequences on its next retry, the
+     * removed ones are not read once this returns
+     * @return true if at least one of the sequences was gating
+    */
+    bool RemoveGatingSequences(const std::vector<Sequence*>& sequences) {
+        std::lock_guard<std::mutex> lock(_gating_mutex);
+        const SequenceGroup* current = _gating_sequences.GetForward();
+        std::vector<Sequence*> updated;
+        for(Sequence* sequence : *current) {
+            if(std::find(sequences.begin(),sequences.end(),sequence) == sequences.end()) {
+                updated.push_back(sequence);
+            }
+        }
+        if(updated.size() == current->size()) {
+            return false;
+        }
+        SwapGatingSequences(new SequenceGroup(updated));
+        return true;
+    }
+
+    size_t GetGatingSequenceCount() {
+        std::lock_guard<std::mutex> lock(_gating_mutex);
+        return _gating_sequences.GetForward()->size();
     }
 
     // Get the value of the cursor indicating the published sequence
@@ -64,19 +188,75 @@ public:
         return _cursor.GetSequence();
     }
 
+    // Whether the claim strategy lets several publishers claim
+    bool IsMultiProducer() const {
+        return _claim_strategy->IsMultiProducer();
+    }
+
+    // Get the wait strategy, e.g. the eventfd of an EventFdStrategy
+    W* GetWaitStrategy() {
+        return _wait_strategy;
+    }
+
     // Create a barrier that gates on the cursor and a list of Sequences
-    SequenceBarrier* NewBarrier(const std::vector<Sequence*>& dependents) {
-        return new SequenceBarrier(_cursor,dependents,_wait_strategy,_claim_strategy);
+    Barrier* NewBarrier(const SequenceGroup& dependents) {
+        return new Barrier(_cursor,dependents,_wait_strategy,_claim_strategy);
+    }
+
+    // Get the number of events in the ring buffer
+    int64_t GetBufferSize() const {
+        return _ring_buffer.GetSize();
+    }
+
+    // How the events were allocated
+    const MemoryRegion& GetBufferMemoryRegion() const {
+        return _ring_buffer.GetMemoryRegion();
     }
 
     bool HasAvailableCapacity() {
-        return _claim_strategy->HasAvailableCapacity(_gating_sequences);
+        return _claim_strategy->HasAvailableCapacity(GatingSequences());
     }
 
     // Claim the next batch of sequence number for publishing
     // return the next available sequence
     int64_t Next(size_t delta = 1) {
-        return _claim_strategy->IncrementAndGet(_gating_sequences,delta);
+        return _claim_strategy->IncrementAndGet(GatingSequences(),delta);
+    }
+
+    // Claim the next batch of sequence number only if the ring buffer has
+    // room for it, never waits for the consumers
+    // return the last claimed sequence, kInsufficientCapacitySignal if full
+    int64_t TryNext(size_t delta = 1) {
+        return _claim_strategy->TryIncrementAndGet(GatingSequences(),delta);
+    }
+
+    /**
+     * @brief Claim a batch of delta sequences, fill its slots in place
+     * then Publish(batch). The batch addresses the slots with the slot
+     * layout of the ring buffer, see ClaimedBatch
+    */
+    ClaimedBatch<T> Claim(size_t delta) {
+        return MakeBatch(Next(delta),delta);
+    }
+
+    // Claim a batch only if the ring buffer has room for it, the batch is
+    // empty if it does not
+    ClaimedBatch<T> TryClaim(size_t delta) {
+        const int64_t high_bound = TryNext(delta);
+        if(high_bound == kInsufficientCapacitySignal) {
+            return ClaimedBatch<T>(0,kInitialCursorValue);
+        }
+        return MakeBatch(high_bound,delta);
+    }
+
+    void Publish(const ClaimedBatch<T>& batch) {
+        Publish(batch.GetLowBound(),batch.GetHighBound());
+    }
+
+    // Get the contiguous slots of up to count sequences from sequence on,
+    // for any slot layout
+    SlotSpan<T> GetSpan(int64_t sequence,int64_t count) {
+        return _ring_buffer.GetSpan(sequence,count);
     }
 
     /// @brief Used for producer to publish events
@@ -93,16 +273,41 @@ public:
         _wait_strategy->SignalAllWhenBlocking();
     }
 
+    // Used by the consumers after advancing their sequence to wake the
+    // producers blocked on a full ring buffer
+    void SignalProducersWhenBlocking() {
+        _producer_wait_strategy->SignalAllWhenBlocking();
+    }
+
     // Get value use operator[]
     T* operator[](const int64_t& sequence) {
         return _ring_buffer[sequence];
     }
 
 private:
-    RingBuffer<T> _ring_buffer;
+    ClaimedBatch<T> MakeBatch(int64_t high_bound,int64_t delta) {
+        return ClaimedBatch<T>(high_bound - delta + 1L,high_bound,_ring_buffer.GetSlotAddressing());
+    }
+
+    const SequenceGroup& GatingSequences() const {
+        return _gating_sequences;
+    }
+
+    // called with _gating_mutex held
+    void SwapGatingSequences(SequenceGroup* sequences) {
+        delete _gating_sequences.Forward(sequences);
+        // a minimum the producers cached from the previous set may not
+        // bound the new one
+        _claim_strategy->InvalidateGatingCache();
+        // the producers blocked on the previous set wait on the new one
+        _producer_wait_strategy->SignalAllWhenBlocking();
+    }
+
+    R _ring_buffer;
     Sequence _cursor;
-    ClaimStrategy* _claim_strategy;
-    WaitStrategy* _wait_strategy;
+    ProducerWaitStrategy* _producer_wait_strategy;
+    C* _claim_strategy;
+    W* _wait_strategy;
 
     /**
      * Each consumer will maintain their own Sequence object to 
@@ -112,9 +317,22 @@ private:
      * By accessing _gating_sequences, the Sequencer can determine 
      * where the slowest consumer has spent.
     */
-    // Records the sequence of consumers
-    std::vector<Sequence*> _gating_sequences;
+    // Records the sequence of consumers, forwards to the current set
+    SequenceGroup _gating_sequences;
+    // serializes the writers of _gating_sequences
+    std::mutex _gating_mutex;
 };
+/**
+ * @brief Sequencer over a FixedRingBuffer of N packed events, its
+ * constructor takes no buffer size nor slot layout
+ * @example FixedSequencer<Event,1024,SingleThreadStrategy,BusySpinStrategy>
+*/
+template<typename T,
+         size_t N,
+         typename C = ClaimStrategy,
+         typename W = WaitStrategy>
+using FixedSequencer = Sequencer<T,C,W,FixedRingBuffer<T,N>>;
+
 } // end namespace disruptor
 
 #endif
\ No newline at end of file
@@ -0,0 +1,254 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_SHARDED_SEQUENCER_H_
+#define DISRUPTOR_SHARDED_SEQUENCER_H_
+
+#include <vector>
+#include "sequencer.h"
+
+namespace disruptor {
+
+template<typename T,typename W>
+class ShardedSequenceBarrier;
+
+/**
+ * @brief Multi publisher sequencer made of one single writer ring(shard)
+ * per registered publisher. A publisher only claims and publishes on its own
+ * shard, so there is no compare and set and no available buffer: aggregate
+ * throughput scales with the number of publishers instead of contending on
+ * one cursor. Consumers read a merged view of the shards through a
+ * ShardedSequenceBarrier(see ShardedEventProcessor).
+ *
+ * Register every publisher with AddProducer() and every consumer before
+ * publishing starts, neither is thread safe.
+ * @param T EventType
+ * @param W wait strategy policy of the merged barriers
+*/
+template<typename T,typename W = BusySpinStrategy>
+class ShardedSequencer
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(ShardedSequencer);
+    friend class ShardedSequenceBarrier<T,W>;
+public:
+    using Barrier = ShardedSequenceBarrier<T,W>;
+
+    /**
+     * @brief Single writer ring of one publisher. Its publish also wakes the
+     * merged barriers parked on the sequencer: a fence and a load while none
+     * is parked. The Sequencer is a private base, so no publish can bypass
+     * the signal through it. No consumer waits on a shard itself, so its
+     * own wait strategy is BusySpinStrategy, whose signal does nothing.
+    */
+    class Shard : private Sequencer<T,SingleThreadStrategy,BusySpinStrategy>
+    {
+        DISALLOW_COPY_MOVE_AND_ASSIGN(Shard);
+        using Base = Sequencer<T,SingleThreadStrategy,BusySpinStrategy>;
+        friend class ShardedSequencer;
+    public:
+        using EventType = T;
+        using Base::Next;
+        using Base::TryNext;
+        using Base::Claim;
+        using Base::TryClaim;
+        using Base::GetSpan;
+        using Base::operator[];
+        using Base::GetCursor;
+        using Base::GetBufferSize;
+        using Base::HasAvailableCapacity;
+        using Base::SignalProducersWhenBlocking;
+
+        explicit Shard(ShardedSequencer* sequencer,
+                       int64_t buffer_size,
+                       ProducerWaitStrategyOption producer_wait_option)
+            : Base(buffer_size,kSingleThreadClaimStrategy,kBusySpinStrategy,
+                   kWideAvailableBuffer,producer_wait_option),
+              _sequencer(sequencer) {}
+
+        void Publish(const int64_t& sequence) {
+            Base::Publish(sequence);
+            _sequencer->SignalWhenParked();
+        }
+
+        void Publish(int64_t low_bound,int64_t high_bound) {
+            Base::Publish(low_bound,high_bound);
+            _sequencer->SignalWhenParked();
+        }
+
+        void Publish(const ClaimedBatch<T>& batch) {
+            Publish(batch.GetLowBound(),batch.GetHighBound());
+        }
+
+    private:
+        ShardedSequencer* _sequencer;
+    };
+
+    // wait_option selects W of the merged barriers when W is WaitStrategy
+    explicit ShardedSequencer(int64_t shard_buffer_size = kDefaultRingBufferSize,
+                              WaitStrategyOption wait_option = kBusySpinStrategy,
+                              ProducerWaitStrategyOption producer_wait_option = kYieldingProducerWait)
+        : _shard_buffer_size(shard_buffer_size),
+          _producer_wait_option(producer_wait_option),
+          _wait_strategy(WaitStrategyBuilder<W>::Build(wait_option)),
+          _parked(0) {}
+
+    ~ShardedSequencer() {
+        for(Shard* shard : _shards) {
+            delete shard;
+        }
+        delete _wait_strategy;
+    }
+
+    // Register a publisher and return the shard it publishes on
+    Shard* AddProducer() {
+        _shards.push_back(new Shard(this,_shard_buffer_size,_producer_wait_option));
+        _gating_sequences.push_back(std::vector<Sequence*>());
+        return _shards.back();
+    }
+
+    // Add the sequences(one per shard) of a consumer reading every shard
+    void AddGatingSequences(const std::vector<Sequence*>& sequences) {
+        for(size_t i = 0; i < _shards.size() && i < sequences.size(); ++i) {
+            _gating_sequences[i].push_back(sequences[i]);
+            _shards[i]->SetGatingSequences(_gating_sequences[i]);
+        }
+    }
+
+    // Create a barrier merging the shards registered so far
+    Barrier* NewBarrier() {
+        return new Barrier(this);
+    }
+
+    size_t GetShardCount() const {
+        return _shards.size();
+    }
+
+    Shard* GetShard(size_t index) {
+        return _shards[index];
+    }
+
+private:
+    inline void SignalWhenParked() {
+        // pairs with the fence of ShardedSequenceBarrier::WaitFor: either
+        // the publisher sees the parked barrier or the barrier sees the
+        // published cursor
+        std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+        if(_parked.load(std::memory_order::memory_order_relaxed) > 0) {
+            _signal_sequence.IncrementAndGet(1L);
+            _wait_strategy->SignalAllWhenBlocking();
+        }
+    }
+
+    int64_t _shard_buffer_size;
+    ProducerWaitStrategyOption _producer_wait_option;
+    std::vector<Shard*> _shards;
+    std::vector<std::vector<Sequence*>> _gating_sequences;
+    // the merged barriers wait through W on _signal_sequence, which the
+    // shards advance while a barrier is parked
+    W* _wait_strategy;
+    Sequence _signal_sequence;
+    std::atomic<int64_t> _parked;
+};
+
+/**
+ * @brief Merged view of the shards of a ShardedSequencer for one consumer.
+ * WaitFor() returns once any shard has new events: it reads the shard
+ * cursors kDefaultRetryLoops times, then parks in the wait strategy W until
+ * a shard publishes, as SequenceBarrier::WaitFor does for one ring.
+ * It is not a SequenceBarrier: each shard has its own sequences, so
+ * WaitFor takes the next sequence and returns the available one per shard.
+*/
+template<typename T,typename W>
+class ShardedSequenceBarrier
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(ShardedSequenceBarrier);
+public:
+    explicit ShardedSequenceBarrier(ShardedSequencer<T,W>* sequencer)
+        : _sequencer(sequencer),
+          _alerted(false) {}
+
+    /**
+     * @brief Wait until a shard has events from its next sequence on
+     * @param next_sequences per shard, the next sequence to read
+     * @param available_sequences per shard, set to the published cursor
+     * @return false if the barrier is alerted
+    */
+    bool WaitFor(const std::vector<int64_t>& next_sequences,
+                 std::vector<int64_t>& available_sequences) {
+        int64_t counter = kDefaultRetryLoops;
+        while(!Alerted()) {
+            if(Scan(next_sequences,available_sequences)) {
+                return true;
+            }
+            if(counter) {
+                --counter;
+                continue;
+            }
+            const int64_t signal_sequence = _sequencer->_signal_sequence.GetSequence();
+            _sequencer->_parked.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+            if(!Scan(next_sequences,available_sequences)) {
+                _sequencer->_wait_strategy->BarrierWaitFor(signal_sequence + 1L,_sequencer->_signal_sequence,
+                                                           _no_dependents,_alerted,_wait_state);
+            }
+            _sequencer->_parked.fetch_sub(1);
+        }
+        return false;
+    }
+
+    inline bool Alerted() const {
+        return _alerted.load(std::memory_order::memory_order_acquire);
+    }
+
+    inline void SetAlerted(bool alert) {
+        _alerted.store(alert,std::memory_order::memory_order_release);
+    }
+
+    // wake the barrier parked in W, for an alert
+    inline void SignalAllWhenBlocking() {
+        _sequencer->_wait_strategy->SignalAllWhenBlocking();
+    }
+
+private:
+    // single writer shards: a cursor is the published sequence
+    bool Scan(const std::vector<int64_t>& next_sequences,
+              std::vector<int64_t>& available_sequences) {
+        bool available = false;
+        for(size_t i = 0; i < next_sequences.size(); ++i) {
+            available_sequences[i] = _sequencer->GetShard(i)->GetCursor();
+            available |= available_sequences[i] >= next_sequences[i];
+        }
+        return available;
+    }
+
+    ShardedSequencer<T,W>* _sequencer;
+    const SequenceGroup _no_dependents;
+    std::atomic<bool> _alerted;
+    WaitState _wait_state;
+};
+
+} // end namespace disruptor
+
+#endif
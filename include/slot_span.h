@@ -0,0 +1,155 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_SLOT_SPAN_H_
+#define DISRUPTOR_SLOT_SPAN_H_
+
+#include <algorithm>
+#include <cstdint>
+
+namespace disruptor {
+
+// Slots of consecutive sequences which are contiguous in the ring buffer
+template<typename T>
+struct SlotSpan
+{
+    SlotSpan(T* data = nullptr,int64_t size = 0)
+        : data(data),
+          size(size) {}
+
+    T* begin() const {
+        return data;
+    }
+
+    T* end() const {
+        return data + size;
+    }
+
+    T* data;
+    int64_t size;
+};
+
+/**
+ * @brief Where the slots of a ring buffer are: groups of 1 << group_shift
+ * slots, each group starting group_stride bytes after the previous one.
+ * The packed layout is a single group of size slots
+*/
+template<typename T>
+struct SlotAddressing
+{
+    SlotAddressing(char* events = nullptr,
+                   int64_t size = 1,
+                   int64_t group_shift = 0,
+                   size_t group_stride = sizeof(T))
+        : events(events),
+          size(size),
+          group_shift(group_shift),
+          group_mask((int64_t(1) << group_shift) - 1),
+          group_stride(group_stride) {}
+
+    // the slot of sequence
+    T* operator[](int64_t sequence) const {
+        const int64_t index = sequence & (size - 1);
+        return reinterpret_cast<T*>(events + (index >> group_shift) * group_stride
+                                           + (index & group_mask) * sizeof(T));
+    }
+
+    // the contiguous slots of up to count sequences from sequence on: up
+    // to the end of the ring when the groups are back to back, else up to
+    // the end of the group
+    SlotSpan<T> GetSpan(int64_t sequence,int64_t count) const {
+        const int64_t index = sequence & (size - 1);
+        int64_t contiguous = size - index;
+        if(group_stride != (sizeof(T) << group_shift)) {
+            contiguous = (group_mask + 1) - (index & group_mask);
+        }
+        return SlotSpan<T>((*this)[sequence],std::min(count,contiguous));
+    }
+
+    char* events;
+    int64_t size;
+    int64_t group_shift;
+    int64_t group_mask;
+    size_t group_stride;
+};
+
+/**
+ * @brief A batch of claimed sequences. The caller fills the slots in
+ * place, then publishes the whole batch with one call:
+ *      for(int64_t offset = 0; offset < batch.size(); ) {
+ *          SlotSpan<Event> span = batch.GetSpan(offset);
+ *          std::copy(inputs + offset,inputs + offset + span.size,span.begin());
+ *          offset += span.size;
+ *      }
+ * A packed batch is at most two spans, split at the ring wrap, a padded
+ * or grouped one a span per slot or per group.
+ * An empty batch(size 0) is returned by a failed try claim
+*/
+template<typename T>
+class ClaimedBatch
+{
+public:
+    ClaimedBatch(int64_t low_bound,
+                 int64_t high_bound,
+                 const SlotAddressing<T>& slots = SlotAddressing<T>())
+        : _low_bound(low_bound),
+          _high_bound(high_bound),
+          _slots(slots) {}
+
+    int64_t GetLowBound() const {
+        return _low_bound;
+    }
+
+    int64_t GetHighBound() const {
+        return _high_bound;
+    }
+
+    int64_t size() const {
+        return _high_bound - _low_bound + 1L;
+    }
+
+    bool empty() const {
+        return size() <= 0;
+    }
+
+    // the contiguous slots from the offset-th sequence of the batch on
+    SlotSpan<T> GetSpan(int64_t offset) const {
+        return _slots.GetSpan(_low_bound + offset,size() - offset);
+    }
+
+    // the event of the index-th sequence of the batch
+    T* operator[](int64_t index) const {
+        return _slots[_low_bound + index];
+    }
+
+private:
+    int64_t _low_bound;
+    int64_t _high_bound;
+    SlotAddressing<T> _slots;
+};
+
+} // end namespace disruptor
+
+#endif
\ No newline at end of file
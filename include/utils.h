@@ -26,6 +26,13 @@
 #ifndef DISRUPTOR_UTILS_H_
 #define DISRUPTOR_UTILS_H_
 
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 #define DISALLOW_COPY_MOVE_AND_ASSIGN(Typename) \
     Typename(const Typename&) = delete;         \
     Typename(Typename&&) = delete;              \
@@ -41,6 +48,16 @@ namespace util {
         }
         return r;
     }
+
+    // Hint the cpu that the thread is spinning, which frees pipeline
+    // resources for the sibling hyper thread and saves power
+    inline void CpuPause() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
 }
 }
 
@@ -27,14 +27,28 @@
 #define DISRUPTOR_WAIT_STRATEGY_H_
 
 #include <sys/time.h>
+#include <algorithm>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <condition_variable>
 #include <vector>
 #include <mutex>
 #include <thread>
 
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#include <ctime>
+#endif
+
+#include "clock.h"
 #include "sequence.h"
+#include "sequence_group.h"
 #include "utils.h"
 
 namespace disruptor {
@@ -54,7 +68,36 @@ enum WaitStrategyOption {
     kYieldingStrategy,
     // This strategy call spins in a loop as a waiting strategy which is
     // lowest and most consistent latency but ties up a CPU.
-    kBusySpinStrategy
+    kBusySpinStrategy,
+    // This strategy blocks like kBlockingStrategy, but the publisher only
+    // takes the lock to signal when an event processor is blocked, which
+    // keeps the throughput close to busy spin under load.
+    kLiteBlockingStrategy,
+    // This strategy parks every event processor on a futex word of the
+    // sequence it waits for, the cursor or one of its dependents, so an
+    // advancing sequence only wakes the processors waiting on it. Falls back
+    // to yielding on other platforms than Linux.
+    kFutexStrategy,
+    // This strategy spins with a cpu pause, then yields, then blocks like
+    // kLiteBlockingStrategy. How long it spins and yields adapts to the
+    // waits observed by each event processor: close to busy spin under
+    // load, blocking when events are rare.
+    kPhasedBackoffStrategy,
+#if defined(__linux__)
+    // This strategy signals a Linux eventfd when the cursor advances, so an
+    // event processor can wait for events in its own epoll loop together
+    // with sockets and timers, and poll the barrier when the fd is readable.
+    // Only defined on Linux, selecting it elsewhere does not compile.
+    kEventFdStrategy
+#endif
+};
+
+// State a wait strategy keeps between the waits of one barrier. The
+// barrier owns it, so the state lives and dies with the barrier
+struct WaitState
+{
+    // PhasedBackoffStrategy's moving average, negative before the first wait
+    int64_t average_wait_nanos = -1;
 };
 
 class WaitStrategy
@@ -71,7 +114,7 @@ public:
     */
     virtual int64_t WaitFor(const int64_t& sequence,
                     const Sequence& cursor,
-                    const std::vector<Sequence*>& dependents,
+                    const SequenceGroup& dependents,
                     const std::atomic<bool>& alarted) = 0;
 
     /**
@@ -89,7 +132,7 @@ public:
     */
     virtual int64_t WaitFor(const int64_t& sequence,
                     const Sequence& cursor,
-                    const std::vector<Sequence*>& dependents,
+                    const SequenceGroup& dependents,
                     const std::atomic<bool>& alerted,
                     const std::chrono::microseconds& timeout) = 0;
 
@@ -98,6 +141,33 @@ public:
      * on this behaviour to unblock.
     */
     virtual void SignalAllWhenBlocking() = 0;
+
+    /**
+     * @brief Signal the strategy that a consumer sequence advanced. Only the
+     * strategies parking the consumers waiting on their dependents use it.
+    */
+    virtual void SignalWhenBlocking(const Sequence& sequence) {}
+
+    /**
+     * @brief WaitFor called by a barrier with the state it keeps for the
+     * strategy, only the strategies adapting to the previous waits use it
+    */
+    virtual int64_t BarrierWaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted,
+                    WaitState& state) {
+        return WaitFor(sequence,cursor,dependents,alerted);
+    }
+
+    virtual int64_t BarrierWaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted,
+                    const std::chrono::microseconds& timeout,
+                    WaitState& state) {
+        return WaitFor(sequence,cursor,dependents,alerted,timeout);
+    }
 };
 
 static inline WaitStrategy* CreateWaitStrategy(WaitStrategyOption option);
@@ -143,14 +213,22 @@ constexpr int64_t kDefaultRetryLoops = 200L;
 constexpr int kDefaultDurationValue = 1;
 
 // used internally
-// inline function allow multi define in file
-static inline std::function<int64_t()> buildMinSequenceFunction(
-    const Sequence& cursor, const std::vector<Sequence*>& dependents);
+// Read the minimum sequence of the dependents, or the cursor when there are
+// no dependents. The dependents are only read again once their cached
+// minimum is behind sequence
+static inline int64_t GetAvailableSequence(const Sequence& cursor,
+                                           const SequenceGroup& dependents,
+                                           const int64_t& sequence) {
+    if(dependents.empty()) {
+        return cursor.GetSequence();
+    }
+    return dependents.GetMinimumSequence(sequence);
+}
 
 /**
  * @brief Strategy employed for a consumer to wait on the sequencer's cursor
 */
-class BusySpinStrategy : public WaitStrategy
+class BusySpinStrategy final : public WaitStrategy
 {
     DISALLOW_COPY_MOVE_AND_ASSIGN(BusySpinStrategy);
 public:
@@ -158,13 +236,12 @@ public:
 
     virtual int64_t WaitFor(const int64_t& sequence,
                     const Sequence& cursor,
-                    const std::vector<Sequence*>& dependents,
+                    const SequenceGroup& dependents,
                     const std::atomic<bool>& alarted) override {
         int64_t available_sequence = kInitialCursorValue;
-        // If there is no dependents(consumers) min_sequence() is cursor.sequence
-        // otherwise min_sequence() is minumum dependents's sequence
-        const auto min_sequence = buildMinSequenceFunction(cursor,dependents);
-        while((available_sequence = min_sequence()) < sequence) {
+        // If there is no dependents(consumers) GetAvailableSequence(cursor,dependents,sequence) is cursor.sequence
+        // otherwise GetAvailableSequence(cursor,dependents,sequence) is minumum dependents's sequence
+        while((available_sequence = GetAvailableSequence(cursor,dependents,sequence)) < sequence) {
             if(alarted.load()) {
                 return kAlertedSignal;
             }
@@ -174,20 +251,18 @@ public:
 
     virtual int64_t WaitFor(const int64_t& sequence,
                     const Sequence& cursor,
-                    const std::vector<Sequence*>& dependents,
+                    const SequenceGroup& dependents,
                     const std::atomic<bool>& alerted,
                     const std::chrono::microseconds& timeout) override {
         int64_t available_value = kInitialCursorValue;
 
-        const auto start = std::chrono::system_clock::now();
-        const auto stop =  start + timeout;
-        const auto min_sequence = buildMinSequenceFunction(cursor,dependents);
+        Deadline deadline(timeout);
 
-        while((available_value = min_sequence()) < sequence) {
+        while((available_value = GetAvailableSequence(cursor,dependents,sequence)) < sequence) {
             if(alerted.load()) {
                 return kAlertedSignal;
             }
-            if(std::chrono::system_clock::now() >= stop) {
+            if(deadline.Expired()) {
                 return kTimeoutSignal;
             }
         }
@@ -197,7 +272,7 @@ public:
     virtual void SignalAllWhenBlocking() override {}
 };
 
-class YieldingStrategy : public WaitStrategy
+class YieldingStrategy final : public WaitStrategy
 {
     DISALLOW_COPY_MOVE_AND_ASSIGN(YieldingStrategy);
 public:
@@ -206,12 +281,11 @@ public:
 
     virtual int64_t WaitFor(const int64_t& sequence,
                     const Sequence& cursor,
-                    const std::vector<Sequence*>& dependents,
+                    const SequenceGroup& dependents,
                     const std::atomic<bool>& alerted) override {
         int64_t available_sequence = kInitialCursorValue;
         int64_t counter = _retry_loop;
-        const auto min_sequence = buildMinSequenceFunction(cursor,dependents);
-        while((available_sequence = min_sequence()) < sequence) {
+        while((available_sequence = GetAvailableSequence(cursor,dependents,sequence)) < sequence) {
             if(alerted.load()) {
                 return kAlertedSignal;
             }
@@ -222,22 +296,21 @@ public:
 
     virtual int64_t WaitFor(const int64_t& sequence,
                     const Sequence& cursor,
-                    const std::vector<Sequence*>& dependents,
+                    const SequenceGroup& dependents,
                     const std::atomic<bool>& alerted,
                     const std::chrono::microseconds& timeout) override {
         int64_t available_sequence = kInitialCursorValue;
         int64_t counter = _retry_loop;
 
-        const auto start = std::chrono::system_clock::now();
-        const auto stop = start + timeout;
-        const auto min_sequence = buildMinSequenceFunction(cursor,dependents);
+        Deadline deadline(timeout);
 
-        while((available_sequence = min_sequence()) < sequence) {
+        while((available_sequence = GetAvailableSequence(cursor,dependents,sequence)) < sequence) {
             if(alerted.load()) {
                 return kAlertedSignal;
             }
             counter = ApplyWaitMethod(counter);
-            if(stop <= std::chrono::system_clock::now()) {
+            // read the clock after every yield, spins are cheaper than a read
+            if(counter ? deadline.Expired() : deadline.ExpiredNow()) {
                 return kTimeoutSignal;
             }
         }
@@ -260,7 +333,7 @@ private:
     int64_t _retry_loop;
 };
 
-class SleepingStrategy : public WaitStrategy
+class SleepingStrategy final : public WaitStrategy
 {
     DISALLOW_COPY_MOVE_AND_ASSIGN(SleepingStrategy);
 public:
@@ -271,14 +344,13 @@ public:
 
     virtual int64_t WaitFor(const int64_t& sequence,
                     const Sequence& cursor,
-                    const std::vector<Sequence*>& dependents,
+                    const SequenceGroup& dependents,
                     const std::atomic<bool>& alerted) override {
         int64_t available_sequence = kInitialCursorValue;
         int64_t counter = _retry_loop;
 
-        const auto min_sequence = buildMinSequenceFunction(cursor,dependents);
 
-        while((available_sequence = min_sequence()) < sequence) {
+        while((available_sequence = GetAvailableSequence(cursor,dependents,sequence)) < sequence) {
             if(alerted.load()) {
                 return kAlertedSignal;
             }
@@ -289,24 +361,23 @@ public:
 
     virtual int64_t WaitFor(const int64_t& sequence,
                     const Sequence& cursor,
-                    const std::vector<Sequence*>& dependents,
+                    const SequenceGroup& dependents,
                     const std::atomic<bool>& alerted,
                     const std::chrono::microseconds& timeout) override {
         int64_t available_sequence = kInitialCursorValue;
         int64_t counter = _retry_loop;
 
-        const auto start = std::chrono::system_clock::now();
-        const auto stop = start + timeout;
-        const auto min_sequence = buildMinSequenceFunction(cursor,dependents);
+        Deadline deadline(timeout);
 
-        while((available_sequence = min_sequence()) < sequence) {
+        while((available_sequence = GetAvailableSequence(cursor,dependents,sequence)) < sequence) {
             if(alerted.load()) {
                 return kAlertedSignal;
             }
             counter = ApplyWaitMethod(counter);
-            if(stop <= std::chrono::system_clock::now()) {
+            // read the clock after every yield or sleep
+            if(counter > (_retry_loop / 2) ? deadline.Expired() : deadline.ExpiredNow()) {
                 return kTimeoutSignal;
-            } 
+            }
         }
         return available_sequence;
     }
@@ -332,7 +403,7 @@ private:
     int64_t _duration_value;
 };
 
-class BlockingStrategy : public WaitStrategy
+class BlockingStrategy final : public WaitStrategy
 {
     DISALLOW_COPY_MOVE_AND_ASSIGN(BlockingStrategy);
     using Lock = std::unique_lock<std::recursive_mutex>;
@@ -342,7 +413,7 @@ public:
 
     virtual int64_t WaitFor(const int64_t& sequence,
                     const Sequence& cursor,
-                    const std::vector<Sequence*>& dependents,
+                    const SequenceGroup& dependents,
                     const std::atomic<bool>& alerted) override {
         return WaitFor(sequence,cursor,dependents,alerted,[this](Lock& lock){
             _consumer_notify_condition.wait(lock);
@@ -352,7 +423,7 @@ public:
 
     virtual int64_t WaitFor(const int64_t& sequence,
                     const Sequence& cursor,
-                    const std::vector<Sequence*>& dependents,
+                    const SequenceGroup& dependents,
                     const std::atomic<bool>& alerted,
                     const std::chrono::microseconds& timeout) override {
         return WaitFor(sequence,cursor,dependents,alerted,
@@ -370,7 +441,7 @@ public:
 private:
     inline int64_t WaitFor(const int64_t& sequence,
                            const Sequence& cursor,
-                           const std::vector<Sequence*>& dependents,
+                           const SequenceGroup& dependents,
                            const std::atomic<bool>& alerted,
                            const Waiter& locker) {
         int64_t available_sequence = kInitialCursorValue;
@@ -396,7 +467,7 @@ private:
 
         // Now wait on dependents
         if(dependents.size()) {
-            while((available_sequence = GetMinimumSequence(dependents)) < sequence) {
+            while((available_sequence = dependents.GetMinimumSequence(sequence)) < sequence) {
                 if(alerted.load()) {
                     return kAlertedSignal;
                 }
@@ -409,6 +480,588 @@ private:
     std::condition_variable_any _consumer_notify_condition;
 };
 
+// BlockingStrategy which counts the blocked event processors, so that
+// SignalAllWhenBlocking() is a fence and a load when none is blocked
+class LiteBlockingStrategy final : public WaitStrategy
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(LiteBlockingStrategy);
+    using Lock = std::unique_lock<std::mutex>;
+public:
+    explicit LiteBlockingStrategy() : _waiters(0) {}
+
+    virtual int64_t WaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted) override {
+        return WaitFor(sequence,cursor,dependents,alerted,[this](Lock& lock){
+            _consumer_notify_condition.wait(lock);
+            return false;
+        });
+    }
+
+    virtual int64_t WaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted,
+                    const std::chrono::microseconds& timeout) override {
+        return WaitFor(sequence,cursor,dependents,alerted,[this,timeout](Lock& lock) {
+            return std::cv_status::timeout ==
+                _consumer_notify_condition.wait_for(lock,timeout);
+        });
+    }
+
+    virtual void SignalAllWhenBlocking() override {
+        // pairs with the fence in WaitFor: either the publisher sees the
+        // waiter or the waiter sees the published cursor
+        std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+        if(_waiters.load(std::memory_order::memory_order_relaxed) > 0) {
+            Lock ulock(_mutex);
+            _consumer_notify_condition.notify_all();
+        }
+    }
+
+private:
+    template<typename Waiter>
+    inline int64_t WaitFor(const int64_t& sequence,
+                           const Sequence& cursor,
+                           const SequenceGroup& dependents,
+                           const std::atomic<bool>& alerted,
+                           const Waiter& locker) {
+        int64_t available_sequence = kInitialCursorValue;
+
+        if((available_sequence = cursor.GetSequence()) < sequence) {
+            Lock ulock(_mutex);
+            _waiters.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+            while((available_sequence = cursor.GetSequence()) < sequence) {
+                if(alerted.load()) {
+                    _waiters.fetch_sub(1);
+                    return kAlertedSignal;
+                }
+                if(locker(ulock)) {
+                    _waiters.fetch_sub(1);
+                    return kTimeoutSignal;
+                }
+            }
+            _waiters.fetch_sub(1);
+        }
+
+        if(dependents.size()) {
+            while((available_sequence = dependents.GetMinimumSequence(sequence)) < sequence) {
+                if(alerted.load()) {
+                    return kAlertedSignal;
+                }
+            }
+        }
+        return available_sequence;
+    }
+
+    std::atomic<int64_t> _waiters;
+    std::mutex _mutex;
+    std::condition_variable _consumer_notify_condition;
+};
+
+namespace util {
+// Sleep while *address equals expected, until woken or timeout(nullptr
+// waits forever). Spurious returns are possible, callers check again
+inline void FutexWait(std::atomic<int32_t>* address,
+                      int32_t expected,
+                      const std::chrono::nanoseconds* timeout = nullptr) {
+#if defined(__linux__)
+    struct timespec relative;
+    struct timespec* relative_timeout = nullptr;
+    if(timeout) {
+        relative.tv_sec = timeout->count() / 1000000000L;
+        relative.tv_nsec = timeout->count() % 1000000000L;
+        relative_timeout = &relative;
+    }
+    syscall(SYS_futex,reinterpret_cast<int32_t*>(address),FUTEX_WAIT_PRIVATE,
+            expected,relative_timeout,nullptr,0);
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Wake every thread sleeping on address
+inline void FutexWakeAll(std::atomic<int32_t>* address) {
+#if defined(__linux__)
+    syscall(SYS_futex,reinterpret_cast<int32_t*>(address),FUTEX_WAKE_PRIVATE,
+            INT_MAX,nullptr,nullptr,0);
+#endif
+}
+} // end namespace util
+
+constexpr size_t kFutexParkingWords = 64;
+
+// Event processors park on a futex word of the sequence they wait for:
+// the cursor word when waiting for the publishers, otherwise the word of
+// a dependent sequence still behind. SignalAllWhenBlocking() wakes the
+// cursor word only, SignalWhenBlocking(sequence) the word of the sequence,
+// so a processor is only woken when the sequence it waits for advanced.
+// The dependent sequences share kFutexParkingWords words by address, a
+// collision only costs a spurious wake up. A signal is a fence and a load
+// when no processor is parked on the word.
+class FutexStrategy final : public WaitStrategy
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(FutexStrategy);
+public:
+    explicit FutexStrategy() {}
+
+    virtual int64_t WaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted) override {
+        return WaitFor(sequence,cursor,dependents,alerted,nullptr);
+    }
+
+    virtual int64_t WaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted,
+                    const std::chrono::microseconds& timeout) override {
+        const Deadline deadline(timeout);
+        return WaitFor(sequence,cursor,dependents,alerted,&deadline);
+    }
+
+    virtual void SignalAllWhenBlocking() override {
+        Wake(_cursor_word);
+    }
+
+    virtual void SignalWhenBlocking(const Sequence& sequence) override {
+        Wake(WordOf(sequence));
+    }
+
+private:
+    // padded to the false sharing range, c++11 new does not honour alignas
+    struct ParkingWord
+    {
+        std::atomic<int32_t> epoch{0};
+        std::atomic<int32_t> waiters{0};
+        char padding[FALSE_SHARING_RANGE_IN_BYTES - 2 * sizeof(std::atomic<int32_t>)];
+    };
+
+    inline ParkingWord& WordOf(const Sequence& sequence) {
+        return _dependent_words[(reinterpret_cast<uintptr_t>(&sequence) / CACHE_LINE_SIZE_IN_BYTES)
+                               % kFutexParkingWords];
+    }
+
+    inline void Wake(ParkingWord& word) {
+        // pairs with the fence in Park: either the signal sees the waiter
+        // or the waiter sees the advanced sequence
+        std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+        if(word.waiters.load(std::memory_order::memory_order_relaxed) > 0) {
+            word.epoch.fetch_add(1,std::memory_order::memory_order_release);
+            util::FutexWakeAll(&word.epoch);
+        }
+    }
+
+    // Park on word until target reaches sequence, the barrier is alerted
+    // or the deadline passes
+    // return false if the deadline passed
+    inline bool Park(ParkingWord& word,
+                     const Sequence& target,
+                     const int64_t& sequence,
+                     const std::atomic<bool>& alerted,
+                     const Deadline* deadline) {
+        std::chrono::nanoseconds remaining;
+        if(deadline) {
+            remaining = std::chrono::nanoseconds(deadline->RemainingNanos());
+            if(remaining.count() <= 0) {
+                return false;
+            }
+        }
+        const int32_t epoch = word.epoch.load(std::memory_order::memory_order_acquire);
+        word.waiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+        if(target.GetSequence() < sequence && !alerted.load()) {
+            util::FutexWait(&word.epoch,epoch,deadline ? &remaining : nullptr);
+        }
+        word.waiters.fetch_sub(1);
+        return true;
+    }
+
+    inline int64_t WaitFor(const int64_t& sequence,
+                           const Sequence& cursor,
+                           const SequenceGroup& dependents,
+                           const std::atomic<bool>& alerted,
+                           const Deadline* deadline) {
+        int64_t available_sequence = kInitialCursorValue;
+        while((available_sequence = cursor.GetSequence()) < sequence) {
+            if(alerted.load()) {
+                return kAlertedSignal;
+            }
+            if(!Park(_cursor_word,cursor,sequence,alerted,deadline)) {
+                return kTimeoutSignal;
+            }
+        }
+
+        if(dependents.size()) {
+            while((available_sequence = dependents.GetMinimumSequence(sequence)) < sequence) {
+                if(alerted.load()) {
+                    return kAlertedSignal;
+                }
+                // park on the first dependent still behind
+                for(Sequence* dependent : dependents) {
+                    if(dependent->GetSequence() < sequence) {
+                        if(!Park(WordOf(*dependent),*dependent,sequence,alerted,deadline)) {
+                            return kTimeoutSignal;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+        return available_sequence;
+    }
+
+    ParkingWord _cursor_word;
+    ParkingWord _dependent_words[kFutexParkingWords];
+};
+
+// Time spent by the event processors in each phase of PhasedBackoffStrategy
+struct PhasedBackoffCounters
+{
+    // every wait, alerted and timed out ones included
+    int64_t waits = 0;
+    int64_t alerted = 0;
+    int64_t timed_out = 0;
+    int64_t spin_nanos = 0;
+    int64_t yield_nanos = 0;
+    int64_t block_nanos = 0;
+};
+
+constexpr int64_t kDefaultPhasedMaxSpinNanos = 50000L;
+constexpr int64_t kDefaultPhasedMaxYieldNanos = 1000000L;
+constexpr int64_t kPhasedMinSpinNanos = 1000L;
+constexpr int64_t kPhasedMinYieldNanos = 10000L;
+// pauses between two reads of the clock while spinning
+constexpr int64_t kPhasedSpinsPerClockRead = 16L;
+
+// Spins with a cpu pause, then yields, then blocks on a LiteBlockingStrategy.
+// An average of the waits is kept in the WaitState of each barrier: a phase
+// lasts twice the average wait when the average fits in the phase's
+// maximum, otherwise only its minimum, so that long idle periods go to
+// blocking almost at once while short gaps are caught spinning. A WaitFor
+// without a barrier state starts from the initial average every time.
+class PhasedBackoffStrategy final : public WaitStrategy
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(PhasedBackoffStrategy);
+public:
+    explicit PhasedBackoffStrategy(int64_t max_spin_nanos = kDefaultPhasedMaxSpinNanos,
+                                   int64_t max_yield_nanos = kDefaultPhasedMaxYieldNanos)
+        : _max_spin_nanos(max_spin_nanos),
+          _max_yield_nanos(max_yield_nanos),
+          _waits(0),
+          _alerted(0),
+          _timed_out(0),
+          _spin_nanos(0),
+          _yield_nanos(0),
+          _block_nanos(0) {}
+
+    virtual int64_t WaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted) override {
+        WaitState state;
+        return WaitFor(sequence,cursor,dependents,alerted,nullptr,state);
+    }
+
+    virtual int64_t WaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted,
+                    const std::chrono::microseconds& timeout) override {
+        WaitState state;
+        const Deadline deadline(timeout);
+        return WaitFor(sequence,cursor,dependents,alerted,&deadline,state);
+    }
+
+    virtual int64_t BarrierWaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted,
+                    WaitState& state) override {
+        return WaitFor(sequence,cursor,dependents,alerted,nullptr,state);
+    }
+
+    virtual int64_t BarrierWaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted,
+                    const std::chrono::microseconds& timeout,
+                    WaitState& state) override {
+        const Deadline deadline(timeout);
+        return WaitFor(sequence,cursor,dependents,alerted,&deadline,state);
+    }
+
+    virtual void SignalAllWhenBlocking() override {
+        _fallback.SignalAllWhenBlocking();
+    }
+
+    PhasedBackoffCounters GetCounters() const {
+        PhasedBackoffCounters counters;
+        counters.waits = _waits.load(std::memory_order::memory_order_relaxed);
+        counters.alerted = _alerted.load(std::memory_order::memory_order_relaxed);
+        counters.timed_out = _timed_out.load(std::memory_order::memory_order_relaxed);
+        counters.spin_nanos = _spin_nanos.load(std::memory_order::memory_order_relaxed);
+        counters.yield_nanos = _yield_nanos.load(std::memory_order::memory_order_relaxed);
+        counters.block_nanos = _block_nanos.load(std::memory_order::memory_order_relaxed);
+        return counters;
+    }
+
+private:
+    // Count a wait which reached the slow path, the phases not entered
+    // last 0. An alerted wait does not update the average
+    inline int64_t CountWait(WaitState& state,
+                             int64_t available_sequence,
+                             int64_t start,
+                             int64_t spin_stop,
+                             int64_t yield_stop,
+                             int64_t end) {
+        if(available_sequence == kAlertedSignal) {
+            _alerted.fetch_add(1L,std::memory_order::memory_order_relaxed);
+        }
+        else {
+            if(available_sequence == kTimeoutSignal) {
+                _timed_out.fetch_add(1L,std::memory_order::memory_order_relaxed);
+            }
+            state.average_wait_nanos += (end - start - state.average_wait_nanos) / 8L;
+        }
+        _waits.fetch_add(1L,std::memory_order::memory_order_relaxed);
+        _spin_nanos.fetch_add(spin_stop - start,std::memory_order::memory_order_relaxed);
+        _yield_nanos.fetch_add(yield_stop - spin_stop,std::memory_order::memory_order_relaxed);
+        _block_nanos.fetch_add(end - yield_stop,std::memory_order::memory_order_relaxed);
+        return available_sequence;
+    }
+
+    inline int64_t PhaseNanos(int64_t average_wait_nanos,
+                              int64_t min_nanos,
+                              int64_t max_nanos) const {
+        if(average_wait_nanos > max_nanos) {
+            return min_nanos;
+        }
+        return std::max(min_nanos,std::min(average_wait_nanos * 2L,max_nanos));
+    }
+
+    static inline int64_t Available(const int64_t& sequence,
+                                    const Sequence& cursor,
+                                    const SequenceGroup& dependents) {
+        const int64_t available_sequence = cursor.GetSequence();
+        if(available_sequence < sequence || dependents.empty()) {
+            return available_sequence;
+        }
+        return dependents.GetMinimumSequence(sequence);
+    }
+
+    inline int64_t WaitFor(const int64_t& sequence,
+                           const Sequence& cursor,
+                           const SequenceGroup& dependents,
+                           const std::atomic<bool>& alerted,
+                           const Deadline* deadline,
+                           WaitState& state) {
+        int64_t available_sequence = Available(sequence,cursor,dependents);
+        if(available_sequence >= sequence) {
+            return available_sequence;
+        }
+
+        if(state.average_wait_nanos < 0) {
+            state.average_wait_nanos = _max_spin_nanos / 2;
+        }
+        const int64_t start = WaitClock::NowNanos();
+        const int64_t spin_end = start +
+            PhaseNanos(state.average_wait_nanos,kPhasedMinSpinNanos,_max_spin_nanos);
+        const int64_t yield_end = spin_end +
+            PhaseNanos(state.average_wait_nanos,kPhasedMinYieldNanos,_max_yield_nanos);
+
+        int64_t now = start;
+        int64_t counter = 0;
+        // spin
+        while((available_sequence = Available(sequence,cursor,dependents)) < sequence) {
+            if(alerted.load()) {
+                now = WaitClock::NowNanos();
+                return CountWait(state,kAlertedSignal,start,now,now,now);
+            }
+            util::CpuPause();
+            if(++counter % kPhasedSpinsPerClockRead == 0) {
+                now = WaitClock::NowNanos();
+                if(now >= spin_end || (deadline && deadline->ExpiredNow())) {
+                    break;
+                }
+            }
+        }
+        const int64_t spin_stop = WaitClock::NowNanos();
+        // yield
+        if(available_sequence < sequence) {
+            while((available_sequence = Available(sequence,cursor,dependents)) < sequence) {
+                now = WaitClock::NowNanos();
+                if(alerted.load()) {
+                    return CountWait(state,kAlertedSignal,start,spin_stop,now,now);
+                }
+                if(now >= yield_end || (deadline && deadline->ExpiredNow())) {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+        const int64_t yield_stop = WaitClock::NowNanos();
+        // block
+        if(available_sequence < sequence) {
+            if(deadline) {
+                const int64_t remaining_nanos = deadline->RemainingNanos();
+                if(remaining_nanos <= 0) {
+                    return CountWait(state,kTimeoutSignal,start,spin_stop,yield_stop,yield_stop);
+                }
+                available_sequence = _fallback.WaitFor(sequence,cursor,dependents,alerted,
+                    std::chrono::microseconds(remaining_nanos / 1000L + 1L));
+            }
+            else {
+                available_sequence = _fallback.WaitFor(sequence,cursor,dependents,alerted);
+            }
+        }
+        return CountWait(state,available_sequence,start,spin_stop,yield_stop,WaitClock::NowNanos());
+    }
+
+    int64_t _max_spin_nanos;
+    int64_t _max_yield_nanos;
+    LiteBlockingStrategy _fallback;
+    // the producers read the fallback waiters on every publish, the
+    // consumers write the counters on every wait
+    int64_t _padding0[CACHE_LINE_PADDING_LENGTH];
+    std::atomic<int64_t> _waits;
+    std::atomic<int64_t> _alerted;
+    std::atomic<int64_t> _timed_out;
+    std::atomic<int64_t> _spin_nanos;
+    std::atomic<int64_t> _yield_nanos;
+    std::atomic<int64_t> _block_nanos;
+    int64_t _padding1[CACHE_LINE_PADDING_LENGTH];
+};
+
+#if defined(__linux__)
+// An eventfd written when the cursor advances, for one epoll consumer.
+// Signals are coalesced: the eventfd is written once until the consumer
+// acknowledges it, so a burst of publishes costs one write
+class EventFdSignal
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(EventFdSignal);
+public:
+    explicit EventFdSignal()
+        : _fd(eventfd(0,EFD_NONBLOCK | EFD_CLOEXEC)),
+          _signalled(false) {}
+
+    ~EventFdSignal() {
+        if(_fd >= 0) {
+            close(_fd);
+        }
+    }
+
+    // -1 if the eventfd could not be created
+    int GetFileDescriptor() const {
+        return _fd;
+    }
+
+    // Drain the eventfd and rearm the signal, call it before polling the
+    // barrier, a publish made after it signals again
+    void Acknowledge() {
+        uint64_t value;
+        while(_fd >= 0 && read(_fd,&value,sizeof(value)) > 0) {
+        }
+        _signalled.store(false,std::memory_order::memory_order_relaxed);
+        // pairs with the fence of EventFdStrategy::SignalAllWhenBlocking:
+        // either the publisher sees the rearmed signal or the consumer
+        // sees the cursor
+        std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+    }
+
+    // called after a seq_cst fence
+    inline void Signal() {
+        if(!_signalled.load(std::memory_order::memory_order_relaxed) &&
+           !_signalled.exchange(true)) {
+            // can not overflow the counter, it is written once per Acknowledge()
+            const uint64_t value = 1;
+            const ssize_t written = write(_fd,&value,sizeof(value));
+            (void)written;
+        }
+    }
+
+private:
+    int _fd;
+    std::atomic<bool> _signalled;
+};
+
+// epoll consumers of an EventFdStrategy
+constexpr size_t kMaxEventFdConsumers = 16;
+
+// Signals an eventfd per epoll consumer when the cursor advances. For an
+// epoll loop, register GetFileDescriptor() for EPOLLIN, and when it is
+// readable call Acknowledge() then SequenceBarrier::Poll() until it has no
+// new events. Acknowledging drains the eventfd, so each further epoll
+// consumer takes its own with AddConsumer().
+// WaitFor() does not read the eventfds, any number of processors block in
+// it like LiteBlockingStrategy.
+class EventFdStrategy final : public WaitStrategy
+{
+    DISALLOW_COPY_MOVE_AND_ASSIGN(EventFdStrategy);
+public:
+    explicit EventFdStrategy() : _consumers(1) {
+        _signals[0].reset(new EventFdSignal());
+    }
+
+    // The eventfd of the first epoll consumer, -1 if it could not be created
+    int GetFileDescriptor() const {
+        return _signals[0]->GetFileDescriptor();
+    }
+
+    // Acknowledge the eventfd of the first epoll consumer
+    void Acknowledge() {
+        _signals[0]->Acknowledge();
+    }
+
+    // Add an epoll consumer with its own eventfd, null if there are
+    // kMaxEventFdConsumers already
+    EventFdSignal* AddConsumer() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const size_t consumers = _consumers.load(std::memory_order::memory_order_relaxed);
+        if(consumers == kMaxEventFdConsumers) {
+            return nullptr;
+        }
+        _signals[consumers].reset(new EventFdSignal());
+        _consumers.store(consumers + 1,std::memory_order::memory_order_release);
+        return _signals[consumers].get();
+    }
+
+    virtual int64_t WaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted) override {
+        return _fallback.WaitFor(sequence,cursor,dependents,alerted);
+    }
+
+    virtual int64_t WaitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const SequenceGroup& dependents,
+                    const std::atomic<bool>& alerted,
+                    const std::chrono::microseconds& timeout) override {
+        return _fallback.WaitFor(sequence,cursor,dependents,alerted,timeout);
+    }
+
+    virtual void SignalAllWhenBlocking() override {
+        std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+        const size_t consumers = _consumers.load(std::memory_order::memory_order_acquire);
+        for(size_t i = 0; i < consumers; ++i) {
+            _signals[i]->Signal();
+        }
+        _fallback.SignalAllWhenBlocking();
+    }
+
+private:
+    std::unique_ptr<EventFdSignal> _signals[kMaxEventFdConsumers];
+    std::atomic<size_t> _consumers;
+    // serializes AddConsumer()
+    std::mutex _mutex;
+    LiteBlockingStrategy _fallback;
+};
+#endif
+
 static inline WaitStrategy* CreateWaitStrategy(WaitStrategyOption option) {
     WaitStrategy* strategy = nullptr;
     switch (option) {
@@ -424,25 +1077,44 @@ static inline WaitStrategy* CreateWaitStrategy(WaitStrategyOption option) {
     case kBusySpinStrategy:
         strategy = new BusySpinStrategy();
         break;
+    case kLiteBlockingStrategy:
+        strategy = new LiteBlockingStrategy();
+        break;
+    case kFutexStrategy:
+        strategy = new FutexStrategy();
+        break;
+    case kPhasedBackoffStrategy:
+        strategy = new PhasedBackoffStrategy();
+        break;
+#if defined(__linux__)
+    case kEventFdStrategy:
+        strategy = new EventFdStrategy();
+        break;
+#endif
     default:
         break;
     }
     return strategy;
 }
 
-static inline std::function<int64_t()> buildMinSequenceFunction(
-    const Sequence& cursor,const std::vector<Sequence*>& dependents) {
-    if(dependents.empty()) {
-        return [&cursor]() -> int64_t {
-            return cursor.GetSequence();
-        };
+// Used by Sequencer to build its wait strategy: a concrete strategy type
+// is constructed directly, the WaitStrategy interface falls back to the
+// runtime option
+template<typename W>
+struct WaitStrategyBuilder
+{
+    static W* Build(WaitStrategyOption option) {
+        return new W();
     }
-    else {
-        return [&dependents]() -> int64_t {
-            return GetMinimumSequence(dependents);
-        };
+};
+
+template<>
+struct WaitStrategyBuilder<WaitStrategy>
+{
+    static WaitStrategy* Build(WaitStrategyOption option) {
+        return CreateWaitStrategy(option);
     }
-}
+};
 
 } // end namespace disruptor
 
@@ -0,0 +1,3 @@
+#include "available_scan.h"
+
+using namespace disruptor;
\ No newline at end of file
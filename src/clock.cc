@@ -0,0 +1,3 @@
+#include "clock.h"
+
+using namespace disruptor;
\ No newline at end of file
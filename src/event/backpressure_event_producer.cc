@@ -0,0 +1,3 @@
+#include "event/backpressure_event_producer.h"
+
+using namespace disruptor;
\ No newline at end of file
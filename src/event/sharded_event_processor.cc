@@ -0,0 +1,3 @@
+#include "event/sharded_event_processor.h"
+
+using namespace disruptor;
\ No newline at end of file
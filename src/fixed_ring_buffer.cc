@@ -0,0 +1,3 @@
+#include "fixed_ring_buffer.h"
+
+using namespace disruptor;
\ No newline at end of file
@@ -0,0 +1,3 @@
+#include "gating_tree.h"
+
+using namespace disruptor;
\ No newline at end of file
@@ -0,0 +1,3 @@
+#include "memory_policy.h"
+
+using namespace disruptor;
\ No newline at end of file
@@ -0,0 +1,3 @@
+#include "producer_wait_strategy.h"
+
+using namespace disruptor;
\ No newline at end of file
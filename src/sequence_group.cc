@@ -0,0 +1,3 @@
+#include "sequence_group.h"
+
+using namespace disruptor;
\ No newline at end of file
@@ -0,0 +1,3 @@
+#include "sharded_sequencer.h"
+
+using namespace disruptor;
\ No newline at end of file
@@ -0,0 +1,3 @@
+#include "slot_span.h"
+
+using namespace disruptor;
\ No newline at end of file
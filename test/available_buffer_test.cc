@@ -0,0 +1,99 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_AVAILABLE_BUFFER_TEST_H_
+#define DISRUPTOR_AVAILABLE_BUFFER_TEST_H_
+
+#include <gtest/gtest.h>
+#include "available_buffer.h"
+#include "sequence.h"
+
+namespace disruptor {
+namespace test {
+
+class AvailableBufferTest : public testing::TestWithParam<AvailableBufferOption>
+{
+public:
+    static constexpr int64_t kTestBufferSize = 128;
+};
+
+TEST_P(AvailableBufferTest,PublishOutOfOrder)
+{
+    AvailableBuffer buffer(kTestBufferSize,GetParam());
+    EXPECT_EQ(buffer.IsAvailable(kFirstSequenceValue),false);
+    EXPECT_EQ(buffer.GetHighestAvailable(kFirstSequenceValue,2L),kInitialCursorValue);
+
+    buffer.SetAvailable(2L);
+    EXPECT_EQ(buffer.IsAvailable(2L),true);
+    EXPECT_EQ(buffer.GetHighestAvailable(kFirstSequenceValue,2L),kInitialCursorValue);
+
+    buffer.SetAvailable(kFirstSequenceValue,1L);
+    EXPECT_EQ(buffer.GetHighestAvailable(kFirstSequenceValue,2L),2L);
+}
+
+TEST_P(AvailableBufferTest,PublishAcrossRounds)
+{
+    AvailableBuffer buffer(kTestBufferSize,GetParam());
+    // first round and most of the second one
+    buffer.SetAvailable(kFirstSequenceValue,kTestBufferSize * 2 - 40);
+    EXPECT_EQ(buffer.GetHighestAvailable(kTestBufferSize,kTestBufferSize * 2 - 1),
+              kTestBufferSize * 2 - 40);
+    // slots published in the previous round are not available in this one
+    EXPECT_EQ(buffer.IsAvailable(kTestBufferSize * 2 - 1),false);
+
+    // a batch crossing the wrap point and two 64 slots words,
+    // with a hole after the wrap
+    const int64_t low_bound = kTestBufferSize * 2 - 39;
+    buffer.SetAvailable(low_bound,kTestBufferSize * 2 + 9);
+    buffer.SetAvailable(kTestBufferSize * 2 + 11,kTestBufferSize * 2 + 80);
+    EXPECT_EQ(buffer.GetHighestAvailable(low_bound,kTestBufferSize * 2 + 80),
+              kTestBufferSize * 2 + 9);
+
+    buffer.SetAvailable(kTestBufferSize * 2 + 10);
+    EXPECT_EQ(buffer.GetHighestAvailable(low_bound,kTestBufferSize * 2 + 80),
+              kTestBufferSize * 2 + 80);
+    EXPECT_EQ(buffer.IsAvailable(kTestBufferSize * 2 + 81),false);
+}
+
+TEST(AvailableBufferMemoryTest,CompactLayoutsUseLessMemory)
+{
+    const int64_t buffer_size = 1024;
+    AvailableBuffer wide(buffer_size,kWideAvailableBuffer);
+    AvailableBuffer compact(buffer_size,kCompactAvailableBuffer);
+    AvailableBuffer bitmap(buffer_size,kBitmapAvailableBuffer);
+    EXPECT_EQ(wide.MemorySize(),buffer_size * sizeof(int64_t));
+    EXPECT_EQ(compact.MemorySize(),buffer_size * sizeof(uint32_t));
+    EXPECT_EQ(bitmap.MemorySize(),buffer_size / 8);
+}
+
+INSTANTIATE_TEST_SUITE_P(AvailableBufferLayouts,AvailableBufferTest,
+                         testing::Values(kWideAvailableBuffer,
+                                         kCompactAvailableBuffer,
+                                         kBitmapAvailableBuffer));
+
+} // end namespace test
+} // end namespace disruptor
+
+#endif
@@ -0,0 +1,55 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_AVAILABLE_SCAN_TEST_H_
+#define DISRUPTOR_AVAILABLE_SCAN_TEST_H_
+
+#include <vector>
+#include <gtest/gtest.h>
+#include "available_scan.h"
+
+namespace disruptor {
+namespace test {
+
+TEST(AvailableScanTest,MatchScalarScanAtEveryMismatch)
+{
+    const int64_t flag = 3L;
+    for(int64_t count = 0; count <= 19; ++count) {
+        for(int64_t mismatch = 0; mismatch <= count; ++mismatch) {
+            std::vector<int64_t> flags(count + 1,flag);
+            // differs only in the high half to catch 32 bits lane compares
+            flags[mismatch] = flag + (1L << 32);
+            EXPECT_EQ(util::CountEqualPrefix(flags.data(),count,flag),
+                      util::CountEqualPrefixScalar(flags.data(),count,flag));
+            EXPECT_EQ(util::CountEqualPrefix(flags.data(),count,flag),
+                      std::min(mismatch,count));
+        }
+    }
+}
+
+} // end namespace test
+} // end namespace disruptor
+
+#endif
@@ -26,6 +26,7 @@
 #ifndef DISRUPTOR_CLAIM_STRATEGY_TEST_H_
 #define DISRUPTOR_CLAIM_STRATEGY_TEST_H_
 
+#include <algorithm>
 #include <vector>
 #include <gtest/gtest.h>
 #include "claim_strategy.h"
@@ -69,6 +70,8 @@ class SingleClaimStrategyTest : public ClaimStrategyTest
 
 TEST_F(SingleClaimStrategyTest,SingleIncrementAndGet)
 {
+    EXPECT_FALSE(strategy->IsMultiProducer());
+
     int64_t return_value = strategy->IncrementAndGet(empty_dependents);
     EXPECT_EQ(return_value,kFirstSequenceValue);
 
@@ -101,6 +104,20 @@ TEST_F(SingleClaimStrategyTest,SingleHasAvailableCapacity)
                 sequence_1.IncrementAndGet(RING_BUFFER_SIZE));
 }
 
+TEST_F(SingleClaimStrategyTest,SingleTryIncrementAndGet)
+{
+    auto one_dependents = OneDependents();
+    EXPECT_EQ(strategy->TryIncrementAndGet(one_dependents,RING_BUFFER_SIZE),
+              kInitialCursorValue + RING_BUFFER_SIZE);
+    // full, nothing is claimed
+    EXPECT_EQ(strategy->TryIncrementAndGet(one_dependents),kInsufficientCapacitySignal);
+    EXPECT_EQ(strategy->TryIncrementAndGet(one_dependents),kInsufficientCapacitySignal);
+
+    sequence_1.IncrementAndGet(1L);
+    EXPECT_EQ(strategy->TryIncrementAndGet(one_dependents,2),kInsufficientCapacitySignal);
+    EXPECT_EQ(strategy->TryIncrementAndGet(one_dependents),kFirstSequenceValue + RING_BUFFER_SIZE);
+}
+
 class MultiClaimStrategyTest : public ClaimStrategyTest
 {
     virtual void SetUp() override {
@@ -110,6 +127,8 @@ class MultiClaimStrategyTest : public ClaimStrategyTest
 
 TEST_F(MultiClaimStrategyTest,MultiIncrementAndGet)
 {
+    EXPECT_TRUE(strategy->IsMultiProducer());
+
     std::atomic<int64_t> return_value_1 = {kInitialCursorValue};
     std::atomic<int64_t> return_value_2 = {kInitialCursorValue};
     std::atomic<int64_t> return_value_3 = {kInitialCursorValue};
@@ -151,6 +170,19 @@ TEST_F(MultiClaimStrategyTest,MultiHasAvailableCapacity)
                     sequence_1.IncrementAndGet(RING_BUFFER_SIZE));
 }
 
+TEST_F(MultiClaimStrategyTest,MultiTryIncrementAndGet)
+{
+    auto one_dependents = OneDependents();
+    EXPECT_EQ(strategy->TryIncrementAndGet(one_dependents,RING_BUFFER_SIZE),
+              kInitialCursorValue + RING_BUFFER_SIZE);
+    EXPECT_EQ(strategy->TryIncrementAndGet(one_dependents),kInsufficientCapacitySignal);
+    EXPECT_EQ(cursor.GetSequence(),kInitialCursorValue + RING_BUFFER_SIZE);
+
+    sequence_1.IncrementAndGet(1L);
+    EXPECT_EQ(strategy->TryIncrementAndGet(one_dependents),kFirstSequenceValue + RING_BUFFER_SIZE);
+    EXPECT_EQ(cursor.GetSequence(),kFirstSequenceValue + RING_BUFFER_SIZE);
+}
+
 TEST_F(MultiClaimStrategyTest,SynchronizePublishingShouldBlockEagerThreads)
 {
     std::atomic<bool> wait(true);
@@ -211,6 +243,112 @@ TEST_F(MultiClaimStrategyTest,SynchronizePublishingShouldBlockEagerThreads)
     EXPECT_EQ(published,kInitialCursorValue + 3L);
 }
 
+TEST_F(MultiClaimStrategyTest,HighestPublishedSequenceAcrossWrap)
+{
+    // first round
+    int64_t round_end = strategy->IncrementAndGet(empty_dependents,RING_BUFFER_SIZE - 2);
+    strategy->Publish(kFirstSequenceValue,round_end);
+    EXPECT_EQ(strategy->GetHighesetPublishedSequence(kFirstSequenceValue,round_end),round_end);
+
+    // batch crossing the wrap point, leave a hole after the wrap
+    const int64_t low_bound = round_end + 1L;
+    const int64_t high_bound = strategy->IncrementAndGet(empty_dependents,5);
+    strategy->Publish(low_bound,low_bound + 2L);
+    strategy->Publish(low_bound + 4L);
+    EXPECT_EQ(strategy->GetHighesetPublishedSequence(low_bound,high_bound),low_bound + 2L);
+
+    strategy->Publish(low_bound + 3L);
+    EXPECT_EQ(strategy->GetHighesetPublishedSequence(low_bound,high_bound),high_bound);
+}
+
+class FetchAddClaimStrategyTest : public ClaimStrategyTest
+{
+    virtual void SetUp() override {
+        strategy = CreateClaimStrategy(kMultiThreadFetchAddClaimStrategy,RING_BUFFER_SIZE,cursor);
+    }
+};
+
+TEST_F(FetchAddClaimStrategyTest,FetchAddIncrementAndGet)
+{
+    EXPECT_TRUE(strategy->IsMultiProducer());
+
+    int64_t return_value_1 = strategy->IncrementAndGet(empty_dependents);
+    int64_t return_value_2 = strategy->IncrementAndGet(empty_dependents,2);
+    EXPECT_EQ(return_value_1,kFirstSequenceValue);
+    EXPECT_EQ(return_value_2,kFirstSequenceValue + 2L);
+    // the cursor records the claimed sequence,nothing is published yet
+    EXPECT_EQ(cursor.GetSequence(),return_value_2);
+    EXPECT_EQ(strategy->GetHighesetPublishedSequence(kFirstSequenceValue,return_value_2),kInitialCursorValue);
+
+    strategy->Publish(return_value_1 + 1L,return_value_2);
+    EXPECT_EQ(strategy->GetHighesetPublishedSequence(kFirstSequenceValue,return_value_2),kInitialCursorValue);
+
+    strategy->Publish(return_value_1);
+    EXPECT_EQ(strategy->GetHighesetPublishedSequence(kFirstSequenceValue,return_value_2),return_value_2);
+}
+
+TEST_F(FetchAddClaimStrategyTest,FetchAddWaitsForWrapPoint)
+{
+    auto one_dependents = OneDependents();
+    int64_t return_value = strategy->IncrementAndGet(one_dependents,RING_BUFFER_SIZE);
+    EXPECT_EQ(return_value,kInitialCursorValue + RING_BUFFER_SIZE);
+    EXPECT_EQ(strategy->HasAvailableCapacity(one_dependents),false);
+
+    std::atomic<int64_t> claimed(kInitialCursorValue);
+    std::thread publisher([&](){
+        claimed.store(strategy->IncrementAndGet(one_dependents));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(1L));
+    // the sequence is reserved but the publisher waits for the consumer
+    EXPECT_EQ(cursor.GetSequence(),return_value + 1L);
+    EXPECT_EQ(claimed.load(),kInitialCursorValue);
+
+    sequence_1.IncrementAndGet(1L);
+    publisher.join();
+    EXPECT_EQ(claimed.load(),return_value + 1L);
+}
+
+TEST_F(FetchAddClaimStrategyTest,ConcurrentClaimsAreUnique)
+{
+    const int64_t claims_per_thread = 1000;
+    std::vector<int64_t> claimed[3];
+    std::vector<std::thread> publishers;
+    for(int i = 0; i < 3; ++i) {
+        publishers.emplace_back([this,&claimed,i,claims_per_thread](){
+            for(int64_t n = 0; n < claims_per_thread; ++n) {
+                claimed[i].push_back(strategy->IncrementAndGet(empty_dependents));
+            }
+        });
+    }
+    for(auto& publisher : publishers) {
+        publisher.join();
+    }
+
+    std::vector<int64_t> all;
+    for(int i = 0; i < 3; ++i) {
+        all.insert(all.end(),claimed[i].begin(),claimed[i].end());
+    }
+    std::sort(all.begin(),all.end());
+    for(size_t i = 0; i < all.size(); ++i) {
+        EXPECT_EQ(all[i],kFirstSequenceValue + static_cast<int64_t>(i));
+    }
+    EXPECT_EQ(cursor.GetSequence(),kInitialCursorValue + 3 * claims_per_thread);
+}
+
+TEST_F(FetchAddClaimStrategyTest,FetchAddTryIncrementAndGet)
+{
+    auto one_dependents = OneDependents();
+    EXPECT_EQ(strategy->IncrementAndGet(one_dependents,RING_BUFFER_SIZE),
+              kInitialCursorValue + RING_BUFFER_SIZE);
+    // a failed try leaves the cursor for the fetch_add claims
+    EXPECT_EQ(strategy->TryIncrementAndGet(one_dependents),kInsufficientCapacitySignal);
+    EXPECT_EQ(cursor.GetSequence(),kInitialCursorValue + RING_BUFFER_SIZE);
+
+    sequence_1.IncrementAndGet(2L);
+    EXPECT_EQ(strategy->TryIncrementAndGet(one_dependents),kFirstSequenceValue + RING_BUFFER_SIZE);
+    EXPECT_EQ(strategy->IncrementAndGet(one_dependents),kFirstSequenceValue + RING_BUFFER_SIZE + 1L);
+}
+
 }   // end namespace test
 }   // end namespace disruptor
 
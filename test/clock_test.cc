@@ -0,0 +1,87 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_CLOCK_TEST_H_
+#define DISRUPTOR_CLOCK_TEST_H_
+
+#include <thread>
+#include <gtest/gtest.h>
+#include "clock.h"
+
+namespace disruptor {
+namespace test {
+
+template<typename Clock>
+static int64_t MeasureSleepNanos(const std::chrono::milliseconds& duration)
+{
+    const int64_t start = Clock::NowNanos();
+    std::this_thread::sleep_for(duration);
+    return Clock::NowNanos() - start;
+}
+
+TEST(ClockTest,SteadyClockMeasuresSleep)
+{
+    const int64_t elapsed = MeasureSleepNanos<SteadyClock>(std::chrono::milliseconds(5L));
+    EXPECT_GE(elapsed,5000000L);
+    EXPECT_LT(elapsed,500000000L);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+TEST(ClockTest,TscClockIsCalibratedOnSteadyClock)
+{
+    const int64_t elapsed = MeasureSleepNanos<TscClock>(std::chrono::milliseconds(20L));
+    // the calibration only lasts 1ms
+    EXPECT_GT(elapsed,18000000L);
+    EXPECT_LT(elapsed,500000000L);
+    const int64_t first = TscClock::NowNanos();
+    const int64_t second = TscClock::NowNanos();
+    EXPECT_LE(first,second);
+}
+#endif
+
+TEST(DeadlineTest,ExpiredOnlyReadsTheClockEveryInterval)
+{
+    Deadline deadline(std::chrono::nanoseconds(0),4);
+    EXPECT_EQ(deadline.ExpiredNow(),true);
+    EXPECT_LE(deadline.RemainingNanos(),0L);
+    // the clock is only read on the fourth call
+    EXPECT_EQ(deadline.Expired(),false);
+    EXPECT_EQ(deadline.Expired(),false);
+    EXPECT_EQ(deadline.Expired(),false);
+    EXPECT_EQ(deadline.Expired(),true);
+}
+
+TEST(DeadlineTest,NotExpiredBeforeTimeout)
+{
+    Deadline deadline(std::chrono::seconds(10L),1);
+    EXPECT_EQ(deadline.Expired(),false);
+    EXPECT_EQ(deadline.ExpiredNow(),false);
+    EXPECT_GT(deadline.RemainingNanos(),0L);
+}
+
+} // end namespace test
+} // end namespace disruptor
+
+#endif
@@ -30,8 +30,14 @@
 #include "event/event_interface.h"
 #include "event/event_producer.h"
 #include "event/event_processor.h"
+#include "event/chunked_event_producer.h"
+#include "event/backpressure_event_producer.h"
+#include "event/sharded_event_processor.h"
 #include "support/stub_event.h"
 #include <gtest/gtest.h>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#endif
 
 namespace disruptor {
 namespace test {
@@ -443,6 +449,27 @@ TEST_F(EventTest,Unicast1P1CWithWaitBlockingStrategy)
     Unicast1P1C();
 }
 
+TEST_F(EventTest,Unicast1P1CWithWaitFutexStrategy)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kSingleThreadClaimStrategy,kFutexStrategy);
+    Unicast1P1C();
+}
+
+TEST_F(EventTest,Unicast1P1CWithWaitPhasedBackoffStrategy)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kSingleThreadClaimStrategy,kPhasedBackoffStrategy);
+    Unicast1P1C();
+}
+
+
+TEST_F(EventTest,Unicast1P1CWithWaitLiteBlockingStrategy)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kSingleThreadClaimStrategy,kLiteBlockingStrategy);
+    Unicast1P1C();
+}
 
 TEST_F(EventTest,Pipeline1P3CWithWaitBusyStrategy)
 {
@@ -472,6 +499,13 @@ TEST_F(EventTest,Pipeline1P3CWithWaitBlockingStrategy)
     Pipeline1P3C();
 }
 
+TEST_F(EventTest,Pipeline1P3CWithWaitFutexStrategy)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kSingleThreadClaimStrategy,kFutexStrategy);
+    Pipeline1P3C();
+}
+
 TEST_F(EventTest,Multicast1P3CWithWaitBusySpinStrategy)
 {
     sequencer = new Sequencer<StubEvent>(ring_buffer_size,
@@ -528,6 +562,20 @@ TEST_F(EventTest,Diamond1P3CWithWaitBlockingStrategy)
     Diamond1P3C();
 }
 
+TEST_F(EventTest,Diamond1P3CWithWaitFutexStrategy)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kSingleThreadClaimStrategy,kFutexStrategy);
+    Diamond1P3C();
+}
+
+TEST_F(EventTest,Diamond1P3CWithWaitPhasedBackoffStrategy)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kSingleThreadClaimStrategy,kPhasedBackoffStrategy);
+    Diamond1P3C();
+}
+
 TEST_F(EventTest,Sequencer3P1CWithWaitBusySpinStrategy)
 {
     sequencer = new Sequencer<StubEvent>(ring_buffer_size,
@@ -556,6 +604,825 @@ TEST_F(EventTest,Sequencer3P1CWithWaitBlockingStrategy)
     Sequencer3P1C();
 }
 
+TEST_F(EventTest,Sequencer3P1CWithWaitFutexStrategy)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kMultiThreadClaimStrategy,kFutexStrategy);
+    Sequencer3P1C();
+}
+
+TEST_F(EventTest,Sequencer3P1CWithWaitPhasedBackoffStrategy)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kMultiThreadClaimStrategy,kPhasedBackoffStrategy);
+    Sequencer3P1C();
+}
+
+TEST_F(EventTest,Sequencer3P1CWithWaitLiteBlockingStrategy)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kMultiThreadClaimStrategy,kLiteBlockingStrategy);
+    Sequencer3P1C();
+}
+
+TEST_F(EventTest,Sequencer3P1CWithFetchAddClaimStrategy)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kMultiThreadFetchAddClaimStrategy,kBusySpinStrategy);
+    Sequencer3P1C();
+}
+
+TEST_F(EventTest,Sequencer3P1CWithCompactAvailableBuffer)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kMultiThreadClaimStrategy,kBusySpinStrategy,kCompactAvailableBuffer);
+    Sequencer3P1C();
+}
+
+TEST_F(EventTest,Sequencer3P1CWithBitmapAvailableBuffer)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kMultiThreadFetchAddClaimStrategy,kBusySpinStrategy,kBitmapAvailableBuffer);
+    Sequencer3P1C();
+}
+
+TEST_F(EventTest,Sequencer3P1CWithBlockingProducerWait)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kMultiThreadClaimStrategy,kBlockingStrategy,
+                    kWideAvailableBuffer,kBlockingProducerWait);
+    Sequencer3P1C();
+}
+
+TEST_F(EventTest,Sequencer3P1CWithSleepingProducerWait)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kMultiThreadFetchAddClaimStrategy,kYieldingStrategy,
+                    kWideAvailableBuffer,kSleepingProducerWait);
+    Sequencer3P1C();
+}
+
+
+TEST_F(EventTest,Sequencer3P1CWithPaddedSlotLayout)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kMultiThreadClaimStrategy,kYieldingStrategy,
+                    kWideAvailableBuffer,kYieldingProducerWait,kPaddedSlotLayout);
+    Sequencer3P1C();
+}
+
+TEST_F(EventTest,Sequencer3P1CWithGroupedSlotLayout)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kMultiThreadFetchAddClaimStrategy,kYieldingStrategy,
+                    kWideAvailableBuffer,kYieldingProducerWait,kGroupedSlotLayout,4);
+    Sequencer3P1C();
+}
+
+TEST_F(EventTest,Sequencer3P1CWithTransparentHugePages)
+{
+    sequencer = new Sequencer<StubEvent>(ring_buffer_size,
+                    kMultiThreadClaimStrategy,kYieldingStrategy,
+                    kCompactAvailableBuffer,kYieldingProducerWait,
+                    kPackedSlotLayout,kDefaultSlotsPerGroup,
+                    MemoryPolicy(kTransparentHugePages));
+    Sequencer3P1C();
+}
+
+// Counts the events which are not padding
+class CountingEventHandler : public EventHandler<StubEvent>
+{
+public:
+    CountingEventHandler() : count(0) {}
+
+    virtual void OnEvent(const int64_t& sequence,StubEvent* event) override {
+        if(event->GetValue() >= 0) {
+            ++count;
+        }
+    }
+    virtual void OnStart() override {}
+    virtual void OnShutdown() override {}
+
+    std::atomic<int64_t> count;
+};
+
+class PaddingEventTranslator : public EventTranslator<StubEvent>
+{
+public:
+    virtual StubEvent* TranslateTo(const int64_t& sequence,StubEvent* event) override {
+        event->SetValue(-1L);
+        return event;
+    }
+};
+
+// Handler not derived from EventHandler, its OnEvent is called directly
+class SummingEventHandler final
+{
+public:
+    SummingEventHandler() : sum(0),started(false),shutdown(false) {}
+
+    inline void OnEvent(const int64_t& sequence,StubEvent* event) {
+        sum += event->GetValue();
+    }
+    void OnStart() {
+        started = true;
+    }
+    void OnShutdown() {
+        shutdown = true;
+    }
+
+    int64_t sum;
+    bool started;
+    bool shutdown;
+};
+
+TEST(StaticEventProcessorTest,TemplatedHandler)
+{
+    const int64_t events = 1000;
+    Sequencer<StubEvent> sequencer(64);
+    std::vector<Sequence*> dependents;
+    SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+    SummingEventHandler event_handler;
+    EventProcessor<StubEvent,Sequencer<StubEvent>,SummingEventHandler> event_processor(&sequencer,barrier,&event_handler);
+    std::thread consumer([&](){
+        event_processor.Run();
+    });
+    std::vector<Sequence*> gating_sequences;
+    gating_sequences.push_back(event_processor.GetSequence());
+    sequencer.SetGatingSequences(gating_sequences);
+
+    StubEventTranslator event_translator;
+    EventProducer<StubEvent> event_producer(&sequencer);
+    for(int64_t i = 0; i < events; ++i) {
+        event_producer.PublishEvent(&event_translator,1);
+    }
+    while(event_processor.GetSequence()->GetSequence() < events - 1) {
+        // wait
+    }
+    event_processor.Stop();
+    consumer.join();
+
+    EXPECT_TRUE(event_handler.started);
+    EXPECT_TRUE(event_handler.shutdown);
+    EXPECT_EQ(event_handler.sum,events * (events - 1) / 2);
+}
+
+TEST(StaticEventProcessorTest,CallableHandler)
+{
+    const int64_t events = 1000;
+    Sequencer<StubEvent> sequencer(64);
+    std::vector<Sequence*> dependents;
+    SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+    int64_t odd_events = 0;
+    auto event_handler = MakeEventHandler<StubEvent>([&odd_events](const int64_t& sequence,StubEvent* event){
+        if(event->GetValue() % 2 != 0) {
+            ++odd_events;
+        }
+    });
+    EventProcessor<StubEvent,Sequencer<StubEvent>,decltype(event_handler)> event_processor(&sequencer,barrier,&event_handler);
+    std::thread consumer([&](){
+        event_processor.Run();
+    });
+    std::vector<Sequence*> gating_sequences;
+    gating_sequences.push_back(event_processor.GetSequence());
+    sequencer.SetGatingSequences(gating_sequences);
+
+    EventProducer<StubEvent> event_producer(&sequencer);
+    for(int64_t i = 0; i < events; ++i) {
+        event_producer.PublishEvent([](const int64_t& sequence,StubEvent* event){
+            event->SetValue(sequence);
+        });
+    }
+    while(event_processor.GetSequence()->GetSequence() < events - 1) {
+        // wait
+    }
+    event_processor.Stop();
+    consumer.join();
+
+    EXPECT_EQ(odd_events,events / 2);
+}
+
+TEST(ChunkedEventProducerTest,Chunked3P1C)
+{
+    const int64_t chunk_size = 8;
+    const int64_t events_per_producer = 21;
+    Sequencer<StubEvent> sequencer(64,kMultiThreadFetchAddClaimStrategy,kBusySpinStrategy);
+    std::vector<Sequence*> dependents;
+    SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+    CountingEventHandler event_handler;
+    EventProcessor<StubEvent> event_processor(&sequencer,barrier,&event_handler);
+    std::thread consumer([&](){
+        event_processor.Run();
+    });
+    std::vector<Sequence*> gating_sequences;
+    gating_sequences.push_back(event_processor.GetSequence());
+    sequencer.SetGatingSequences(gating_sequences);
+
+    StubEventTranslator event_translator;
+    PaddingEventTranslator padding_translator;
+    std::vector<std::thread> producers;
+    for(int i = 0; i < 3; ++i) {
+        producers.emplace_back([&](){
+            ChunkedEventProducer<StubEvent> event_producer(&sequencer,&padding_translator,chunk_size,
+                                    std::chrono::microseconds(100L));
+            for(int64_t n = 0; n < events_per_producer; ++n) {
+                event_producer.PublishEvent(&event_translator);
+            }
+            // three chunks claimed, the last one partially used
+            EXPECT_EQ(event_producer.RemainingInChunk(),3L);
+            event_producer.Flush();
+            EXPECT_EQ(event_producer.RemainingInChunk(),0L);
+        });
+    }
+    for(auto& producer : producers) {
+        producer.join();
+    }
+
+    // every claimed sequence is published,the padding is not counted
+    const int64_t expect_sequence = kInitialCursorValue + 3 * 3 * chunk_size;
+    EXPECT_EQ(sequencer.GetCursor(),expect_sequence);
+    while(event_processor.GetSequence()->GetSequence() < expect_sequence) {
+        // wait
+    }
+    EXPECT_EQ(event_handler.count.load(),3 * events_per_producer);
+
+    event_processor.Stop();
+    consumer.join();
+}
+
+// clock of the flush timeout tests, only moved by them
+struct ManualClock
+{
+    static int64_t NowNanos() {
+        return now_nanos;
+    }
+
+    static int64_t now_nanos;
+};
+
+int64_t ManualClock::now_nanos = 0;
+
+TEST(ChunkedEventProducerTest,FlushIfExpired)
+{
+    Sequencer<StubEvent> sequencer(16,kMultiThreadClaimStrategy,kBusySpinStrategy);
+    std::vector<Sequence*> dependents;
+    SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+    StubEventTranslator event_translator;
+    PaddingEventTranslator padding_translator;
+
+    ChunkedEventProducer<StubEvent,Sequencer<StubEvent>,ManualClock> event_producer(
+        &sequencer,&padding_translator,4,std::chrono::microseconds(1000L));
+    EXPECT_EQ(event_producer.FlushIfExpired(),false);
+    event_producer.PublishEvent(&event_translator);
+    // the cursor records the whole chunk,only the first event is published
+    EXPECT_EQ(sequencer.GetCursor(),kFirstSequenceValue + 3L);
+    EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue),kFirstSequenceValue);
+
+    ManualClock::now_nanos += 999000L;
+    EXPECT_EQ(event_producer.FlushIfExpired(),false);
+    ManualClock::now_nanos += 1000L;
+    EXPECT_EQ(event_producer.FlushIfExpired(),true);
+    EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue),kFirstSequenceValue + 3L);
+    // the padding is marked, not a default event
+    EXPECT_EQ((*sequencer[kFirstSequenceValue + 1L]).GetValue(),-1L);
+    EXPECT_EQ((*sequencer[kFirstSequenceValue + 3L]).GetValue(),-1L);
+}
+
+TEST(ChunkedEventProducerTest,ClaimFlushesAnExpiredChunk)
+{
+    Sequencer<StubEvent> sequencer(32,kMultiThreadClaimStrategy,kBusySpinStrategy);
+    std::vector<Sequence*> dependents;
+    SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+    StubEventTranslator event_translator;
+    PaddingEventTranslator padding_translator;
+
+    ChunkedEventProducer<StubEvent,Sequencer<StubEvent>,ManualClock> event_producer(
+        &sequencer,&padding_translator,16,std::chrono::microseconds(1000L));
+    event_producer.PublishEvent(&event_translator);
+    ManualClock::now_nanos += 2000000L;
+    // the clock is read on the kChunkFlushCheckInterval-th claim of the
+    // chunk, which flushes it and goes on in a new chunk
+    for(int64_t i = 1; i < kChunkFlushCheckInterval; ++i) {
+        event_producer.PublishEvent(&event_translator);
+    }
+    EXPECT_EQ(event_producer.RemainingInChunk(),16L - kChunkFlushCheckInterval);
+    event_producer.PublishEvent(&event_translator);
+    EXPECT_EQ(event_producer.RemainingInChunk(),15L);
+    EXPECT_EQ(sequencer.GetCursor(),kFirstSequenceValue + 31L);
+    EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue),kFirstSequenceValue + 16L);
+    EXPECT_EQ((*sequencer[kFirstSequenceValue + kChunkFlushCheckInterval]).GetValue(),-1L);
+    EXPECT_EQ((*sequencer[kFirstSequenceValue + 15L]).GetValue(),-1L);
+    EXPECT_NE((*sequencer[kFirstSequenceValue + 16L]).GetValue(),-1L);
+}
+
+class BackpressureEventProducerTest : public testing::Test
+{
+public:
+    BackpressureEventProducerTest()
+        : sequencer(4,kMultiThreadClaimStrategy,kBusySpinStrategy) {}
+
+    void Gate() {
+        std::vector<Sequence*> gating_sequences;
+        gating_sequences.push_back(&gating_sequence);
+        sequencer.SetGatingSequences(gating_sequences);
+    }
+
+    Sequencer<StubEvent> sequencer;
+    Sequence gating_sequence;
+    StubEventTranslator event_translator;
+};
+
+TEST_F(BackpressureEventProducerTest,FailOnFull)
+{
+    Gate();
+    BackpressureEventProducer<StubEvent> event_producer(&sequencer,kFailOnFull);
+    EXPECT_EQ(event_producer.TryPublishEvent(&event_translator,4),true);
+    StubEvent event;
+    event.SetValue(7L);
+    EXPECT_EQ(event_producer.TryPublishEvent(&event),false);
+    EXPECT_EQ(event.GetValue(),7L);
+    EXPECT_EQ(sequencer.GetCursor(),kInitialCursorValue + 4L);
+
+    gating_sequence.SetSequence(kFirstSequenceValue);
+    EXPECT_EQ(event_producer.TryPublishEvent(&event),true);
+    EXPECT_EQ((*sequencer[kFirstSequenceValue + 4L]).GetValue(),7L);
+
+    const BackpressureCounters& counters = event_producer.GetCounters();
+    EXPECT_EQ(counters.published,5L);
+    EXPECT_EQ(counters.rejected,1L);
+    EXPECT_EQ(counters.dropped,0L);
+}
+
+TEST_F(BackpressureEventProducerTest,DropNewestOnFull)
+{
+    Gate();
+    BackpressureEventProducer<StubEvent> event_producer(&sequencer,kDropNewestOnFull);
+    EXPECT_EQ(event_producer.TryPublishEvent(&event_translator,3),true);
+    EXPECT_EQ(event_producer.TryPublishEvent(&event_translator,2),false);
+    EXPECT_EQ(event_producer.TryPublishEvent(&event_translator,1),true);
+    EXPECT_EQ(event_producer.TryPublishEvent(&event_translator,1),false);
+
+    const BackpressureCounters& counters = event_producer.GetCounters();
+    EXPECT_EQ(counters.published,4L);
+    EXPECT_EQ(counters.dropped,3L);
+    EXPECT_EQ(counters.rejected,0L);
+}
+
+TEST_F(BackpressureEventProducerTest,OverwriteOldestOnFull)
+{
+    // the reader does not gate the sequencer, which has a single producer
+    Sequencer<StubEvent> single_sequencer(4,kSingleThreadClaimStrategy,kBusySpinStrategy);
+    BackpressureEventProducer<StubEvent> event_producer(&single_sequencer,kOverwriteOldestOnFull);
+    std::vector<Sequence*> observed_sequences;
+    observed_sequences.push_back(&gating_sequence);
+    event_producer.SetObservedSequences(observed_sequences);
+
+    EXPECT_EQ(event_producer.TryPublishEvent(&event_translator,4),true);
+    EXPECT_EQ(event_producer.TryPublishEvent(&event_translator,2),true);
+    EXPECT_EQ(event_producer.GetCounters().overwritten,2L);
+
+    gating_sequence.SetSequence(kFirstSequenceValue + 2L);
+    EXPECT_EQ(event_producer.TryPublishEvent(&event_translator,2),true);
+    EXPECT_EQ(event_producer.GetCounters().overwritten,3L);
+    EXPECT_EQ(event_producer.GetCounters().published,8L);
+    EXPECT_EQ(single_sequencer.GetCursor(),kInitialCursorValue + 8L);
+}
+
+TEST_F(BackpressureEventProducerTest,WaitWithTimeoutOnFull)
+{
+    Gate();
+    BackpressureEventProducer<StubEvent> event_producer(&sequencer,kWaitWithTimeoutOnFull,
+                                                        std::chrono::microseconds(1000L));
+    EXPECT_EQ(event_producer.TryPublishEvent(&event_translator,4),true);
+    EXPECT_EQ(event_producer.TryPublishEvent(&event_translator),false);
+    EXPECT_EQ(event_producer.GetCounters().timed_out,1L);
+
+    // the consumer frees a slot while the producer waits
+    std::thread consumer([&](){
+        std::this_thread::sleep_for(std::chrono::microseconds(200L));
+        gating_sequence.SetSequence(kFirstSequenceValue);
+    });
+    BackpressureEventProducer<StubEvent> waiting_producer(&sequencer,kWaitWithTimeoutOnFull,
+                                                          std::chrono::seconds(10L));
+    EXPECT_EQ(waiting_producer.TryPublishEvent(&event_translator),true);
+    EXPECT_EQ(waiting_producer.GetCounters().timed_out,0L);
+    consumer.join();
+}
+
+#if defined(__linux__)
+TEST(EventFdSequencerTest,ConsumeFromEpollLoop)
+{
+    using EventFdSequencer = Sequencer<StubEvent,SingleThreadStrategy,EventFdStrategy>;
+    const int64_t events = 1000;
+    EventFdSequencer sequencer(64);
+    std::vector<Sequence*> dependents;
+    EventFdSequencer::Barrier* barrier = sequencer.NewBarrier(dependents);
+    Sequence consumer_sequence;
+    std::vector<Sequence*> gating_sequences;
+    gating_sequences.push_back(&consumer_sequence);
+    sequencer.SetGatingSequences(gating_sequences);
+
+    const int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    ASSERT_GE(epoll_fd,0);
+    struct epoll_event registered;
+    registered.events = EPOLLIN;
+    registered.data.fd = sequencer.GetWaitStrategy()->GetFileDescriptor();
+    ASSERT_EQ(epoll_ctl(epoll_fd,EPOLL_CTL_ADD,registered.data.fd,&registered),0);
+
+    std::thread producer([&](){
+        StubEventTranslator event_translator;
+        EventProducer<StubEvent,EventFdSequencer> event_producer(&sequencer);
+        for(int64_t n = 0; n < events; ++n) {
+            event_producer.PublishEvent(&event_translator,1);
+        }
+    });
+
+    int64_t handled = 0;
+    int64_t next_sequence = kFirstSequenceValue;
+    while(next_sequence < events) {
+        struct epoll_event ready;
+        if(epoll_wait(epoll_fd,&ready,1,1000) != 1) {
+            continue;
+        }
+        sequencer.GetWaitStrategy()->Acknowledge();
+        int64_t available_sequence;
+        while((available_sequence = barrier->Poll(next_sequence)) >= next_sequence) {
+            for(; next_sequence <= available_sequence; ++next_sequence) {
+                EXPECT_EQ((*sequencer[next_sequence]).GetValue(),next_sequence);
+                ++handled;
+            }
+            consumer_sequence.SetSequence(available_sequence);
+        }
+    }
+    producer.join();
+    close(epoll_fd);
+    EXPECT_EQ(handled,events);
+}
+#endif
+
+// not move constructible, published with memcpy
+struct PinnedEvent
+{
+    PinnedEvent() : value(0) {}
+    PinnedEvent(PinnedEvent&&) = delete;
+
+    int64_t value;
+};
+
+TEST(EventProducerTest,PublishNotMovableEvent)
+{
+    Sequencer<PinnedEvent> sequencer(4);
+    std::vector<Sequence*> dependents;
+    SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+    EventProducer<PinnedEvent> event_producer(&sequencer);
+    PinnedEvent event;
+    event.value = 42;
+    event_producer.PublishEvent(&event,2);
+    EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue),kFirstSequenceValue + 1L);
+    EXPECT_EQ(sequencer[kFirstSequenceValue]->value,42);
+    EXPECT_EQ(sequencer[kFirstSequenceValue + 1L]->value,42);
+}
+
+TEST(EventProducerTest,PublishEventsAcrossTheWrap)
+{
+    for(SlotLayoutOption layout : {kPackedSlotLayout,kPaddedSlotLayout,kGroupedSlotLayout}) {
+        Sequencer<StubEvent> sequencer(8,kSingleThreadClaimStrategy,kBusySpinStrategy,
+                                       kWideAvailableBuffer,kYieldingProducerWait,layout);
+        Sequence gating_sequence(5L);
+        sequencer.SetGatingSequences(std::vector<Sequence*>({&gating_sequence}));
+        std::vector<Sequence*> dependents;
+        SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+        EventProducer<StubEvent> event_producer(&sequencer);
+
+        std::vector<StubEvent> events;
+        for(int64_t i = 0; i < 6; ++i) {
+            events.push_back(StubEvent(100 + i));
+        }
+        event_producer.PublishEvents(events.data(),6);
+        event_producer.PublishEvents(events.data(),6);
+        // the second batch is sequences 6 to 11, slots 6, 7 then 0 to 3
+        EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue),11L);
+        for(int64_t sequence = 6; sequence <= 11; ++sequence) {
+            EXPECT_EQ(sequencer[sequence]->GetValue(),100 + sequence - 6);
+        }
+    }
+}
+
+// counts the wake ups of the consumers, never waits
+class CountingWaitStrategy : public WaitStrategy
+{
+public:
+    CountingWaitStrategy() : signals(0) {}
+
+    virtual int64_t WaitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const SequenceGroup& dependents,
+                            const std::atomic<bool>& alerted) override {
+        return cursor.GetSequence();
+    }
+
+    virtual int64_t WaitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const SequenceGroup& dependents,
+                            const std::atomic<bool>& alerted,
+                            const std::chrono::microseconds& timeout) override {
+        return cursor.GetSequence();
+    }
+
+    virtual void SignalAllWhenBlocking() override {
+        ++signals;
+    }
+
+    int64_t signals;
+};
+
+// stores the inputs and the length of each run it is given
+class RunRecordingTranslator : public EventTranslatorBatch<StubEvent,int64_t>
+{
+public:
+    virtual void TranslateTo(const int64_t* inputs,
+                             const int64_t& first_sequence,
+                             const SlotSpan<StubEvent>& events) override {
+        runs.push_back(events.size);
+        for(int64_t i = 0; i < events.size; ++i) {
+            events.data[i].SetValue(inputs[i] + first_sequence + i);
+        }
+    }
+
+    std::vector<int64_t> runs;
+};
+
+TEST(EventProducerTest,TranslatedBatchIsPublishedOnce)
+{
+    using CountingSequencer = Sequencer<StubEvent,ClaimStrategy,CountingWaitStrategy>;
+    CountingSequencer sequencer(8,kMultiThreadClaimStrategy);
+    std::vector<Sequence*> dependents;
+    CountingSequencer::Barrier* barrier = sequencer.NewBarrier(dependents);
+    EventProducer<StubEvent,CountingSequencer> event_producer(&sequencer);
+
+    StubEventTranslator event_translator;
+    event_producer.PublishEvent(&event_translator,4);
+    EXPECT_EQ(sequencer.GetWaitStrategy()->signals,1);
+    // every sequence of the batch is available to the consumers
+    EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue),kFirstSequenceValue + 3L);
+
+    // sequences 4 to 9 wrap, the translator gets two runs
+    RunRecordingTranslator batch_translator;
+    const int64_t inputs[6] = {1000,1000,1000,1000,1000,1000};
+    Sequence gating_sequence(3L);
+    sequencer.SetGatingSequences(std::vector<Sequence*>({&gating_sequence}));
+    event_producer.PublishEvents(&batch_translator,inputs,6);
+    EXPECT_EQ(sequencer.GetWaitStrategy()->signals,2);
+    EXPECT_EQ(batch_translator.runs,std::vector<int64_t>({4,2}));
+    EXPECT_EQ(barrier->WaitFor(4L),9L);
+    for(int64_t sequence = 4; sequence <= 9; ++sequence) {
+        EXPECT_EQ(sequencer[sequence]->GetValue(),1000 + sequence);
+    }
+}
+
+TEST(EventProducerTest,PublishEventWithCallableTranslator)
+{
+    Sequencer<StubEvent> sequencer(8);
+    std::vector<Sequence*> dependents;
+    SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+    EventProducer<StubEvent> event_producer(&sequencer);
+
+    event_producer.PublishEvent([](const int64_t& sequence,StubEvent* event){
+        event->SetValue(sequence + 100);
+    });
+    event_producer.PublishEvent([](const int64_t& sequence,StubEvent* event,int64_t price,int quantity){
+        event->SetValue(price * quantity);
+    },25L,4);
+    // the pointer overloads are not taken for callables
+    StubEventTranslator event_translator;
+    event_producer.PublishEvent(&event_translator,1);
+
+    EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue),2L);
+    EXPECT_EQ(sequencer[0]->GetValue(),100);
+    EXPECT_EQ(sequencer[1]->GetValue(),100);
+    EXPECT_EQ(sequencer[2]->GetValue(),2);
+}
+
+TEST(GatingTreeTest,Multicast1P16C)
+{
+    const size_t consumer_count = 16;
+    const int64_t events = 2000;
+    Sequencer<StubEvent> sequencer(64,kSingleThreadClaimStrategy,kYieldingStrategy);
+    std::vector<Sequence*> dependents;
+    SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+
+    std::vector<std::unique_ptr<CountingEventHandler>> event_handlers;
+    std::vector<std::unique_ptr<EventProcessor<StubEvent>>> event_processors;
+    std::vector<Sequence*> leaves;
+    for(size_t i = 0; i < consumer_count; ++i) {
+        event_handlers.emplace_back(new CountingEventHandler());
+        event_processors.emplace_back(new EventProcessor<StubEvent>
+                        (&sequencer,barrier,event_handlers.back().get()));
+        leaves.push_back(event_processors.back()->GetSequence());
+    }
+    // the producer is only gated on the root
+    GatingTree gating_tree(leaves,4);
+    sequencer.SetGatingSequences(std::vector<Sequence*>({gating_tree.GetRoot()}));
+    std::vector<std::thread> consumers;
+    for(size_t i = 0; i < consumer_count; ++i) {
+        event_processors[i]->SetGatingTree(&gating_tree,i);
+        EventProcessor<StubEvent>* event_processor = event_processors[i].get();
+        consumers.emplace_back([event_processor](){
+            event_processor->Run();
+        });
+    }
+
+    StubEventTranslator event_translator;
+    EventProducer<StubEvent> event_producer(&sequencer);
+    for(int64_t n = 0; n < events; ++n) {
+        event_producer.PublishEvent(&event_translator,1);
+    }
+    while(gating_tree.GetRoot()->GetSequence() < events - 1) {
+        // wait
+    }
+    for(size_t i = 0; i < consumer_count; ++i) {
+        EXPECT_EQ(event_handlers[i]->count.load(),events);
+        event_processors[i]->Stop();
+    }
+    for(auto& consumer : consumers) {
+        consumer.join();
+    }
+}
+
+TEST(DynamicGatingTest,AttachAndDetachWhileProducing)
+{
+    const int64_t events = 5000;
+    Sequencer<StubEvent> sequencer(8,kMultiThreadClaimStrategy,kYieldingStrategy);
+    std::vector<Sequence*> dependents;
+    SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+
+    CountingEventHandler first_event_handler;
+    EventProcessor<StubEvent> first_event_processor(&sequencer,barrier,&first_event_handler);
+    sequencer.SetGatingSequences(std::vector<Sequence*>({first_event_processor.GetSequence()}));
+    std::thread first_consumer([&](){
+        first_event_processor.Run();
+    });
+
+    StubEventTranslator event_translator;
+    std::thread producer([&](){
+        EventProducer<StubEvent> event_producer(&sequencer);
+        for(int64_t n = 0; n < events; ++n) {
+            event_producer.PublishEvent(&event_translator,1);
+        }
+    });
+
+    while(sequencer.GetCursor() < events / 4) {
+        std::this_thread::yield();
+    }
+    // attach a consumer to the live ring, it starts after the cursor
+    CountingEventHandler second_event_handler;
+    EventProcessor<StubEvent> second_event_processor(&sequencer,barrier,&second_event_handler);
+    sequencer.AddGatingSequences(std::vector<Sequence*>({second_event_processor.GetSequence()}));
+    const int64_t joined_at = second_event_processor.GetSequence()->GetSequence();
+    std::thread second_consumer([&](){
+        second_event_processor.Run();
+    });
+
+    // detach the first consumer, the producer keeps going
+    while(sequencer.GetCursor() < events / 2) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(sequencer.RemoveGatingSequences(
+                std::vector<Sequence*>({first_event_processor.GetSequence()})),true);
+    producer.join();
+
+    while(second_event_processor.GetSequence()->GetSequence() < events - 1) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(second_event_handler.count.load(),events - 1 - joined_at);
+    first_event_processor.Stop();
+    second_event_processor.Stop();
+    first_consumer.join();
+    second_consumer.join();
+}
+
+TEST(DynamicGatingTest,RemoveStoppedConsumerUnblocksProducer)
+{
+    const ProducerWaitStrategyOption producer_waits[] = {kYieldingProducerWait,kBlockingProducerWait};
+    for(ProducerWaitStrategyOption producer_wait : producer_waits) {
+        Sequencer<StubEvent> sequencer(8,kSingleThreadClaimStrategy,kYieldingStrategy,
+                                       kWideAvailableBuffer,producer_wait);
+        std::vector<Sequence*> dependents;
+        SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+        CountingEventHandler event_handler;
+        EventProcessor<StubEvent> event_processor(&sequencer,barrier,&event_handler);
+        sequencer.SetGatingSequences(std::vector<Sequence*>({event_processor.GetSequence()}));
+
+        // the only consumer is not running(stopped), the ring fills up
+
+        StubEventTranslator event_translator;
+        std::atomic<bool> done(false);
+        std::thread producer([&](){
+            EventProducer<StubEvent> event_producer(&sequencer);
+            for(int64_t n = 0; n < 8 + 1; ++n) {
+                event_producer.PublishEvent(&event_translator,1);
+            }
+            done.store(true);
+        });
+        while(sequencer.GetCursor() < 7) {
+            std::this_thread::yield();
+        }
+        // the producer is blocked in Next() on the full ring
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        EXPECT_FALSE(done.load());
+
+        EXPECT_EQ(sequencer.RemoveGatingSequences(
+                    std::vector<Sequence*>({event_processor.GetSequence()})),true);
+        producer.join();
+        EXPECT_TRUE(done.load());
+        EXPECT_EQ(sequencer.GetCursor(),8L);
+    }
+}
+
+TEST(ShardedSequencerTest,Sharded3P1C)
+{
+    using StubShardedSequencer = ShardedSequencer<StubEvent>;
+    const int64_t events_per_producer = 100;
+    StubShardedSequencer sequencer(8);
+    std::vector<StubShardedSequencer::Shard*> shards;
+    for(int i = 0; i < 3; ++i) {
+        shards.push_back(sequencer.AddProducer());
+    }
+    EXPECT_EQ(sequencer.GetShardCount(),3UL);
+
+    CountingEventHandler event_handler;
+    ShardedEventProcessor<StubEvent> event_processor(&sequencer,&event_handler);
+    std::thread consumer([&](){
+        event_processor.Run();
+    });
+
+    // each producer publishes more than its shard holds,
+    // so it is gated by the processor
+    StubEventTranslator event_translator;
+    std::vector<std::thread> producers;
+    for(int i = 0; i < 3; ++i) {
+        StubShardedSequencer::Shard* shard = shards[i];
+        producers.emplace_back([&event_translator,shard,events_per_producer](){
+            EventProducer<StubEvent,StubShardedSequencer::Shard> event_producer(shard);
+            for(int64_t n = 0; n < events_per_producer; ++n) {
+                event_producer.PublishEvent(&event_translator,1);
+            }
+        });
+    }
+    for(auto& producer : producers) {
+        producer.join();
+    }
+
+    for(size_t shard = 0; shard < sequencer.GetShardCount(); ++shard) {
+        while(event_processor.GetSequence(shard)->GetSequence() < events_per_producer - 1) {
+            // wait
+        }
+        EXPECT_EQ(sequencer.GetShard(shard)->GetCursor(),events_per_producer - 1);
+    }
+    EXPECT_EQ(event_handler.count.load(),3 * events_per_producer);
+
+    event_processor.Stop();
+    consumer.join();
+}
+
+TEST(ShardedSequencerTest,ParkedConsumerWakesOnPublishAndStop)
+{
+    using BlockingShardedSequencer = ShardedSequencer<StubEvent,LiteBlockingStrategy>;
+    // a shard can only be published through, it signals the parked consumer
+    EXPECT_FALSE((std::is_convertible<BlockingShardedSequencer::Shard*,
+                                      Sequencer<StubEvent,SingleThreadStrategy,BusySpinStrategy>*>::value));
+    EXPECT_FALSE((std::is_convertible<BlockingShardedSequencer::Shard*,
+                                      Sequencer<StubEvent,SingleThreadStrategy,LiteBlockingStrategy>*>::value));
+    BlockingShardedSequencer sequencer(8);
+    std::vector<BlockingShardedSequencer::Shard*> shards;
+    for(int i = 0; i < 2; ++i) {
+        shards.push_back(sequencer.AddProducer());
+    }
+    CountingEventHandler event_handler;
+    ShardedEventProcessor<StubEvent,LiteBlockingStrategy> event_processor(&sequencer,&event_handler);
+    std::thread consumer([&](){
+        event_processor.Run();
+    });
+
+    // the idle consumer parks in the wait strategy, each publish wakes it
+    StubEventTranslator event_translator;
+    for(int round = 0; round < 3; ++round) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        EventProducer<StubEvent,BlockingShardedSequencer::Shard> event_producer(shards[round % 2]);
+        event_producer.PublishEvent(&event_translator,1);
+        while(event_handler.count.load() < round + 1) {
+            std::this_thread::yield();
+        }
+    }
+    EXPECT_EQ(event_processor.GetSequence(0)->GetSequence(),1L);
+    EXPECT_EQ(event_processor.GetSequence(1)->GetSequence(),0L);
+
+    // stopping alerts the parked consumer
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    event_processor.Stop();
+    consumer.join();
+    EXPECT_EQ(event_handler.count.load(),3L);
+}
 
 } // end namespace test
 
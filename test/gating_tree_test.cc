@@ -0,0 +1,112 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_GATING_TREE_TEST_H_
+#define DISRUPTOR_GATING_TREE_TEST_H_
+
+#include <thread>
+#include <gtest/gtest.h>
+#include "gating_tree.h"
+
+namespace disruptor {
+namespace test {
+
+    static std::vector<Sequence*> LeafPointers(std::vector<Sequence>& leaves)
+    {
+        std::vector<Sequence*> pointers;
+        for(Sequence& leaf : leaves) {
+            pointers.push_back(&leaf);
+        }
+        return pointers;
+    }
+
+    TEST(GatingTreeTest,BuildLevelsByFanOut)
+    {
+        std::vector<Sequence> single(1);
+        EXPECT_EQ(GatingTree(LeafPointers(single),4).GetDepth(),1UL);
+
+        std::vector<Sequence> leaves(64);
+        EXPECT_EQ(GatingTree(LeafPointers(leaves),4).GetDepth(),3UL);
+        EXPECT_EQ(GatingTree(LeafPointers(leaves),8).GetDepth(),2UL);
+        EXPECT_EQ(GatingTree(LeafPointers(leaves),64).GetDepth(),1UL);
+    }
+
+    TEST(GatingTreeTest,RootStartsAtMinimumOfLeaves)
+    {
+        std::vector<Sequence> leaves(10);
+        for(size_t i = 0; i < leaves.size(); ++i) {
+            leaves[i].SetSequence(20L - i);
+        }
+        GatingTree tree(LeafPointers(leaves),3);
+        EXPECT_EQ(tree.GetLeafCount(),10UL);
+        EXPECT_EQ(tree.GetRoot()->GetSequence(),11L);
+    }
+
+    TEST(GatingTreeTest,UpdatePropagatesToRoot)
+    {
+        std::vector<Sequence> leaves(20);
+        GatingTree tree(LeafPointers(leaves),4);
+        EXPECT_EQ(tree.GetRoot()->GetSequence(),kInitialCursorValue);
+
+        // the root follows the slowest leaf
+        for(size_t i = 0; i < leaves.size(); ++i) {
+            leaves[i].SetSequence(5L);
+            tree.Update(i);
+            const int64_t expect = i + 1 < leaves.size() ? kInitialCursorValue : 5L;
+            EXPECT_EQ(tree.GetRoot()->GetSequence(),expect);
+        }
+
+        leaves[7].SetSequence(9L);
+        tree.Update(7);
+        EXPECT_EQ(tree.GetRoot()->GetSequence(),5L);
+    }
+
+    TEST(GatingTreeTest,ConcurrentUpdatesReachMinimum)
+    {
+        const int64_t iterations = 20000;
+        std::vector<Sequence> leaves(16);
+        GatingTree tree(LeafPointers(leaves),4);
+
+        std::vector<std::thread> consumers;
+        for(size_t i = 0; i < leaves.size(); ++i) {
+            consumers.emplace_back([&tree,&leaves,i,iterations](){
+                for(int64_t n = 0; n < iterations; ++n) {
+                    leaves[i].SetSequence(n);
+                    tree.Update(i);
+                    // the root never runs ahead of a leaf
+                    EXPECT_LE(tree.GetRoot()->GetSequence(),n);
+                }
+            });
+        }
+        for(auto& consumer : consumers) {
+            consumer.join();
+        }
+        EXPECT_EQ(tree.GetRoot()->GetSequence(),iterations - 1);
+    }
+
+} // end namespace test
+} // end namespace disruptor
+
+#endif
\ No newline at end of file
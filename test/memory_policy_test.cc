@@ -0,0 +1,119 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_MEMORY_POLICY_TEST_H_
+#define DISRUPTOR_MEMORY_POLICY_TEST_H_
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include "memory_policy.h"
+#include "ring_buffer.h"
+#include "available_buffer.h"
+
+namespace disruptor {
+namespace test {
+
+    // huge pages, NUMA binding and locking depend on the host, every
+    // policy must at least give usable memory
+    static void ExpectUsable(const MemoryRegion& region)
+    {
+        ASSERT_NE(region.GetAddress(),nullptr);
+        std::memset(region.GetAddress(),0x5A,region.GetSize());
+        const unsigned char* bytes = static_cast<const unsigned char*>(region.GetAddress());
+        EXPECT_EQ(bytes[0],0x5A);
+        EXPECT_EQ(bytes[region.GetSize() - 1],0x5A);
+    }
+
+    TEST(MemoryPolicyTest,DefaultPolicyUsesTheHeap)
+    {
+        EXPECT_TRUE(MemoryPolicy().IsDefault());
+        MemoryRegion region(1000);
+        ExpectUsable(region);
+        EXPECT_FALSE(region.IsMapped());
+        EXPECT_FALSE(region.IsHugeTlb());
+        EXPECT_FALSE(region.IsBound());
+        EXPECT_FALSE(region.IsLocked());
+    }
+
+    TEST(MemoryPolicyTest,AlignHeapMemory)
+    {
+        for(size_t alignment : {size_t(64),size_t(128),size_t(4096)}) {
+            MemoryRegion region(1000,MemoryPolicy(),alignment);
+            ExpectUsable(region);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(region.GetAddress()) % alignment,0UL);
+        }
+    }
+
+#if defined(__linux__)
+    TEST(MemoryPolicyTest,TransparentHugePagesAreMapped)
+    {
+        MemoryRegion region(3 * kHugePageSize / 2,MemoryPolicy(kTransparentHugePages));
+        ExpectUsable(region);
+        EXPECT_TRUE(region.IsMapped());
+        EXPECT_FALSE(region.IsHugeTlb());
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(region.GetAddress()) % 4096,0UL);
+    }
+
+    TEST(MemoryPolicyTest,HugeTlbFallsBackWhenThePoolIsEmpty)
+    {
+        MemoryRegion region(4096,MemoryPolicy(kHugeTlbPages));
+        ExpectUsable(region);
+        EXPECT_TRUE(region.IsMapped());
+        if(region.IsHugeTlb()) {
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(region.GetAddress()) % kHugePageSize,0UL);
+        }
+    }
+
+    TEST(MemoryPolicyTest,BindAndLockAreBestEffort)
+    {
+        MemoryRegion region(64 * 1024,MemoryPolicy(kNoHugePages,0,true));
+        ExpectUsable(region);
+        EXPECT_TRUE(region.IsMapped());
+    }
+#endif
+
+    TEST(MemoryPolicyTest,RingAndAvailableBufferFollowThePolicy)
+    {
+        const MemoryPolicy policy(kTransparentHugePages);
+        RingBuffer<int64_t> ring_buffer(1024,kPackedSlotLayout,kDefaultSlotsPerGroup,policy);
+        for(int64_t i = 0; i < 1024; ++i) {
+            *ring_buffer[i] = i;
+        }
+        EXPECT_EQ(*ring_buffer[1023 + 1024],1023);
+
+        AvailableBuffer available_buffer(1024,kBitmapAvailableBuffer,policy);
+        EXPECT_FALSE(available_buffer.IsAvailable(0));
+        available_buffer.SetAvailable(0);
+        EXPECT_TRUE(available_buffer.IsAvailable(0));
+#if defined(__linux__)
+        EXPECT_TRUE(ring_buffer.GetMemoryRegion().IsMapped());
+        EXPECT_TRUE(available_buffer.GetMemoryRegion().IsMapped());
+#endif
+    }
+
+} // end namespace test
+} // end namespace disruptor
+
+#endif
\ No newline at end of file
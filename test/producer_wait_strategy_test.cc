@@ -0,0 +1,86 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_PRODUCER_WAIT_STRATEGY_TEST_H_
+#define DISRUPTOR_PRODUCER_WAIT_STRATEGY_TEST_H_
+
+#include <atomic>
+#include <thread>
+#include <gtest/gtest.h>
+#include "producer_wait_strategy.h"
+
+namespace disruptor {
+namespace test {
+
+class ProducerWaitStrategyTest : public testing::TestWithParam<ProducerWaitStrategyOption>
+{
+public:
+    ProducerWaitStrategyTest() : strategy(CreateProducerWaitStrategy(GetParam())) {
+        dependents.push_back(&gating_sequence);
+    }
+
+    ~ProducerWaitStrategyTest() {
+        delete strategy;
+    }
+
+    ProducerWaitStrategy* strategy;
+    Sequence gating_sequence;
+    std::vector<Sequence*> dependents;
+};
+
+TEST_P(ProducerWaitStrategyTest,ReturnWhenWrapPointIsPassed)
+{
+    gating_sequence.SetSequence(10L);
+    EXPECT_EQ(strategy->WaitFor(5L,dependents),10L);
+}
+
+TEST_P(ProducerWaitStrategyTest,WaitForConsumerToAdvance)
+{
+    std::atomic<bool> completed(false);
+    std::thread producer([&](){
+        EXPECT_EQ(strategy->WaitFor(kFirstSequenceValue,dependents),kFirstSequenceValue);
+        completed.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(1L));
+    EXPECT_EQ(completed.load(),false);
+
+    // the consumer advances then signals, as EventProcessor does
+    gating_sequence.SetSequence(kFirstSequenceValue);
+    strategy->SignalAllWhenBlocking();
+    producer.join();
+    EXPECT_EQ(completed.load(),true);
+}
+
+INSTANTIATE_TEST_SUITE_P(ProducerWaitStrategies,
+                         ProducerWaitStrategyTest,
+                         testing::Values(kYieldingProducerWait,
+                                         kBusySpinProducerWait,
+                                         kSleepingProducerWait,
+                                         kBlockingProducerWait));
+
+} // end namespace test
+} // end namespace disruptor
+
+#endif
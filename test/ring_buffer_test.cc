@@ -27,7 +27,9 @@
 #define DISRUPTOR_RING_BUFFER_TEST_H_
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include "ring_buffer.h"
+#include "fixed_ring_buffer.h"
 
 namespace disruptor {
 namespace test {
@@ -67,6 +69,218 @@ TEST_F(RingBufferTest,RingBufferOperator)
     }
 }
 
+struct TickEvent
+{
+    int64_t price;
+    int64_t quantity;
+};
+
+class SlotLayoutTest : public testing::TestWithParam<SlotLayoutOption>
+{
+public:
+    static constexpr int kTestRingBufferSize = 16;
+
+    static size_t Distance(TickEvent* first,TickEvent* second) {
+        return reinterpret_cast<char*>(second) - reinterpret_cast<char*>(first);
+    }
+};
+
+TEST_P(SlotLayoutTest,SlotsAreDistinctAndWrap)
+{
+    RingBuffer<TickEvent> ring_buffer(kTestRingBufferSize,GetParam(),4);
+    EXPECT_EQ(ring_buffer.GetSlotLayout(),GetParam());
+    for(int64_t i = 0; i < kTestRingBufferSize; ++i) {
+        ring_buffer[i]->price = i;
+        ring_buffer[i]->quantity = -i;
+    }
+    for(int64_t i = 0; i < kTestRingBufferSize * 2; ++i) {
+        EXPECT_EQ(ring_buffer[i]->price,i % kTestRingBufferSize);
+        EXPECT_EQ(ring_buffer[i]->quantity,-(i % kTestRingBufferSize));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ring_buffer[i]) % alignof(TickEvent),0UL);
+    }
+    // the first slot starts a false sharing range
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ring_buffer[0]) % FALSE_SHARING_RANGE_IN_BYTES,0UL);
+}
+
+TEST_P(SlotLayoutTest,SlotsShareRangesByLayout)
+{
+    RingBuffer<TickEvent> ring_buffer(kTestRingBufferSize,GetParam(),4);
+    const size_t range = FALSE_SHARING_RANGE_IN_BYTES;
+    switch(GetParam()) {
+    case kPackedSlotLayout:
+        EXPECT_EQ(Distance(ring_buffer[0],ring_buffer[1]),sizeof(TickEvent));
+        EXPECT_EQ(ring_buffer.MemorySize(),kTestRingBufferSize * sizeof(TickEvent));
+        break;
+    case kPaddedSlotLayout:
+        EXPECT_EQ(Distance(ring_buffer[0],ring_buffer[1]),range);
+        EXPECT_EQ(ring_buffer.MemorySize(),kTestRingBufferSize * range);
+        break;
+    case kGroupedSlotLayout:
+        // four slots per range
+        EXPECT_EQ(Distance(ring_buffer[0],ring_buffer[3]),3 * sizeof(TickEvent));
+        EXPECT_EQ(Distance(ring_buffer[0],ring_buffer[4]),range);
+        EXPECT_EQ(ring_buffer.MemorySize(),kTestRingBufferSize / 4 * range);
+        break;
+    }
+}
+
+TEST(GroupedSlotLayoutTest,SlotsPerGroupRoundDownToPowerOf2)
+{
+    RingBuffer<TickEvent> ring_buffer(16,kGroupedSlotLayout,3);
+    EXPECT_EQ(reinterpret_cast<char*>(ring_buffer[2]) - reinterpret_cast<char*>(ring_buffer[0]),
+              FALSE_SHARING_RANGE_IN_BYTES);
+}
+
+INSTANTIATE_TEST_SUITE_P(SlotLayouts,SlotLayoutTest,
+                         testing::Values(kPackedSlotLayout,kPaddedSlotLayout,kGroupedSlotLayout));
+
+class IndexEventFactory : public EventFactory<TickEvent>
+{
+public:
+    IndexEventFactory() : calls(0) {}
+
+    virtual TickEvent* NewInstance(const int64_t& index,void* memory) override {
+        calls.fetch_add(1);
+        TickEvent* event = new (memory) TickEvent();
+        event->price = index;
+        event->quantity = 2 * index;
+        return event;
+    }
+
+    std::atomic<int64_t> calls;
+};
+
+// counts the events constructed and destroyed
+struct CountedEvent
+{
+    CountedEvent() : value(7) { ++constructed; }
+    ~CountedEvent() { ++destroyed; }
+
+    int64_t value;
+    static std::atomic<int64_t> constructed;
+    static std::atomic<int64_t> destroyed;
+};
+
+std::atomic<int64_t> CountedEvent::constructed(0);
+std::atomic<int64_t> CountedEvent::destroyed(0);
+
+TEST(SlotInitTest,FactoryConstructsEverySlot)
+{
+    IndexEventFactory factory;
+    RingBuffer<TickEvent> ring_buffer(64,kPaddedSlotLayout,kDefaultSlotsPerGroup,MemoryPolicy(),
+                                      SlotInitPolicy<TickEvent>(kSerialSlotInit,0,&factory));
+    EXPECT_EQ(factory.calls.load(),64);
+    for(int64_t i = 0; i < 64; ++i) {
+        EXPECT_EQ(ring_buffer[i]->price,i);
+        EXPECT_EQ(ring_buffer[i]->quantity,2 * i);
+    }
+}
+
+TEST(SlotInitTest,ParallelInitConstructsEverySlotOnce)
+{
+    const int64_t size = kMinSlotsPerInitThread * 4;
+    IndexEventFactory factory;
+    RingBuffer<TickEvent> ring_buffer(size,kGroupedSlotLayout,2,MemoryPolicy(),
+                                      SlotInitPolicy<TickEvent>(kParallelSlotInit,4,&factory));
+    EXPECT_EQ(factory.calls.load(),size);
+    for(int64_t i = 0; i < size; ++i) {
+        ASSERT_EQ(ring_buffer[i]->price,i);
+    }
+
+    const int64_t constructed = CountedEvent::constructed.load();
+    const int64_t destroyed = CountedEvent::destroyed.load();
+    {
+        RingBuffer<CountedEvent> counted(size,kPackedSlotLayout,kDefaultSlotsPerGroup,MemoryPolicy(),
+                                         SlotInitPolicy<CountedEvent>(kParallelSlotInit));
+        EXPECT_EQ(CountedEvent::constructed.load() - constructed,size);
+        EXPECT_EQ(counted[size - 1]->value,7);
+    }
+    EXPECT_EQ(CountedEvent::destroyed.load() - destroyed,size);
+}
+
+TEST(SlotInitTest,LazyInitOnlySkipsTrivialEvents)
+{
+    // mapped memory is zero until written
+    RingBuffer<TickEvent> lazy(1024,kPackedSlotLayout,kDefaultSlotsPerGroup,
+                               MemoryPolicy(kTransparentHugePages),
+                               SlotInitPolicy<TickEvent>(kLazySlotInit));
+    EXPECT_EQ(lazy[1023]->price,0);
+    lazy[1023]->price = 5;
+    EXPECT_EQ(lazy[2047]->price,5);
+
+    const int64_t constructed = CountedEvent::constructed.load();
+    RingBuffer<CountedEvent> counted(16,kPackedSlotLayout,kDefaultSlotsPerGroup,MemoryPolicy(),
+                                     SlotInitPolicy<CountedEvent>(kLazySlotInit));
+    EXPECT_EQ(CountedEvent::constructed.load() - constructed,16);
+}
+
+// trivial default constructor, non trivial destructor
+struct DestroyedEvent
+{
+    DestroyedEvent() = default;
+    ~DestroyedEvent() { ++destroyed; }
+
+    int64_t value;
+    static std::atomic<int64_t> destroyed;
+};
+
+std::atomic<int64_t> DestroyedEvent::destroyed(0);
+
+TEST(SlotInitTest,LazyInitConstructsEventsWhichAreDestroyed)
+{
+    EXPECT_TRUE(IsLazySlotInitSupported<TickEvent>::value);
+    EXPECT_FALSE(IsLazySlotInitSupported<CountedEvent>::value);
+    EXPECT_FALSE(IsLazySlotInitSupported<DestroyedEvent>::value);
+
+    const int64_t destroyed = DestroyedEvent::destroyed.load();
+    {
+        RingBuffer<DestroyedEvent> ring_buffer(16,kPackedSlotLayout,kDefaultSlotsPerGroup,MemoryPolicy(),
+                                               SlotInitPolicy<DestroyedEvent>(kLazySlotInit));
+    }
+    EXPECT_EQ(DestroyedEvent::destroyed.load() - destroyed,16);
+    {
+        const SlotInitPolicy<DestroyedEvent> lazy_init(kLazySlotInit);
+        FixedRingBuffer<DestroyedEvent,16> ring_buffer(MemoryPolicy(),lazy_init);
+    }
+    EXPECT_EQ(DestroyedEvent::destroyed.load() - destroyed,32);
+}
+
+TEST(FixedRingBufferTest,IndexWithConstantMask)
+{
+    FixedRingBuffer<int64_t,8> ring_buffer;
+    EXPECT_EQ(ring_buffer.GetSize(),8);
+    EXPECT_EQ((FixedRingBuffer<int64_t,8>::kIndexMask),7);
+    for(int64_t i = 0; i < 8; ++i) {
+        *ring_buffer[i] = i + 1;
+    }
+    for(int64_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(*ring_buffer[i],(i & 7) + 1);
+    }
+}
+
+TEST(FixedRingBufferTest,SmallRingsAreStoredInline)
+{
+    using SmallRing = FixedRingBuffer<TickEvent,64>;
+    using LargeRing = FixedRingBuffer<TickEvent,1024 * 64>;
+    EXPECT_TRUE(SmallRing::kInline);
+    EXPECT_GE(sizeof(SmallRing),64 * sizeof(TickEvent));
+    EXPECT_FALSE(LargeRing::kInline);
+    EXPECT_LT(sizeof(LargeRing),1024UL);
+
+    SmallRing small;
+    const char* begin = reinterpret_cast<const char*>(&small);
+    const char* slot = reinterpret_cast<const char*>(small[63]);
+    EXPECT_GE(slot,begin);
+    EXPECT_LT(slot,begin + sizeof(SmallRing));
+
+    IndexEventFactory factory;
+    LargeRing large(MemoryPolicy(),SlotInitPolicy<TickEvent>(kSerialSlotInit,0,&factory));
+    EXPECT_EQ(factory.calls.load(),LargeRing::kCapacity);
+    EXPECT_EQ(large[LargeRing::kCapacity + 5]->price,5);
+    // heap slots start a false sharing range
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(large[0]) % FALSE_SHARING_RANGE_IN_BYTES,0UL);
+}
+
 } // end namespace test
 
 } // end namespace disruptor
@@ -92,6 +92,29 @@ TEST_F(SequenceBarrierTest,WaitForCursor)
     EXPECT_EQ(return_value.load(),kFirstSequenceValue + 1L);
 }
 
+TEST_F(SequenceBarrierTest,PollWithoutWaiting)
+{
+    EXPECT_EQ(barrier->Poll(kFirstSequenceValue),kInitialCursorValue);
+    cursor.IncrementAndGet(2L);
+    EXPECT_EQ(barrier->Poll(kFirstSequenceValue),kFirstSequenceValue + 1L);
+
+    barrier->SetAlerted(true);
+    EXPECT_EQ(barrier->Poll(kFirstSequenceValue),kAlertedSignal);
+}
+
+TEST_F(SequenceBarrierTest,PollDependents)
+{
+    SequenceBarrier dependent_barrier(cursor,AllDependents(),
+        CreateWaitStrategy(kBusySpinStrategy),
+        CreateClaimStrategy(kSingleThreadClaimStrategy,1024,cursor));
+    cursor.IncrementAndGet(2L);
+    sequence_1.IncrementAndGet(2L);
+    sequence_2.IncrementAndGet(1L);
+    sequence_3.IncrementAndGet(2L);
+    EXPECT_EQ(dependent_barrier.Poll(kFirstSequenceValue),kFirstSequenceValue);
+    EXPECT_EQ(dependent_barrier.Poll(kFirstSequenceValue + 1L),kFirstSequenceValue);
+}
+
 } // end namespace test
 } // end namespace disruptor
 
@@ -0,0 +1,189 @@
+// Copyright (c) 2024, zgx
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the disruptor-- nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL FRANCOIS SAINT-JACQUES BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DISRUPTOR_SEQUENCE_GROUP_TEST_H_
+#define DISRUPTOR_SEQUENCE_GROUP_TEST_H_
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "sequence_group.h"
+
+namespace disruptor {
+namespace test {
+
+    TEST(SequenceGroupTest,EmptyGroupHasNoMinimum)
+    {
+        SequenceGroup group;
+        EXPECT_TRUE(group.empty());
+        EXPECT_EQ(group.GetMinimumSequence(),LONG_MAX);
+        // nothing is cached, a caller gets no bound past what it required
+        EXPECT_EQ(group.GetMinimumSequence(100L),100L);
+        EXPECT_EQ(group.GetMinimumSequence(5L),5L);
+    }
+
+    TEST(SequenceGroupTest,StoreSmallAndLargeGroups)
+    {
+        std::vector<Sequence> sequences(kSequenceGroupInlineSize * 2);
+        std::vector<Sequence*> pointers;
+        for(size_t i = 0; i < sequences.size(); ++i) {
+            sequences[i].SetSequence(10L + i);
+            pointers.push_back(&sequences[i]);
+        }
+
+        SequenceGroup small(std::vector<Sequence*>(pointers.begin(),
+                                                   pointers.begin() + kSequenceGroupInlineSize));
+        EXPECT_EQ(small.size(),kSequenceGroupInlineSize);
+        EXPECT_EQ(small[kSequenceGroupInlineSize - 1],&sequences[kSequenceGroupInlineSize - 1]);
+        EXPECT_EQ(small.GetMinimumSequence(),10L);
+
+        SequenceGroup large(pointers);
+        EXPECT_EQ(large.size(),pointers.size());
+        EXPECT_EQ(large[pointers.size() - 1],&sequences[pointers.size() - 1]);
+        sequences[0].SetSequence(30L);
+        EXPECT_EQ(large.GetMinimumSequence(),11L);
+
+        // copies keep their own storage
+        SequenceGroup copy = large;
+        large = small;
+        EXPECT_EQ(large.size(),kSequenceGroupInlineSize);
+        EXPECT_EQ(copy.size(),pointers.size());
+        EXPECT_EQ(copy.GetMinimumSequence(),11L);
+    }
+
+    TEST(SequenceGroupTest,CachedMinimumSkipsReads)
+    {
+        Sequence first;
+        Sequence second;
+        first.SetSequence(5L);
+        second.SetSequence(8L);
+        SequenceGroup group(std::vector<Sequence*>({&first,&second}));
+
+        EXPECT_EQ(group.GetMinimumSequence(5L),5L);
+
+        // the cached minimum still satisfies the request, the moved
+        // sequences are not read
+        first.SetSequence(20L);
+        EXPECT_EQ(group.GetMinimumSequence(3L),5L);
+
+        // the cached minimum is used up, every sequence is read again
+        EXPECT_EQ(group.GetMinimumSequence(6L),8L);
+        EXPECT_EQ(group.GetMinimumSequence(9L),8L);
+        second.SetSequence(25L);
+        EXPECT_EQ(group.GetMinimumSequence(9L),20L);
+    }
+
+    TEST(SequenceGroupTest,ForwardToReplacedSequences)
+    {
+        Sequence first(5L);
+        Sequence second(8L);
+        SequenceGroup group;
+        EXPECT_EQ(group.Forward(new SequenceGroup(std::vector<Sequence*>({&first}))),nullptr);
+        EXPECT_EQ(group.GetMinimumSequence(),5L);
+        EXPECT_EQ(group.GetForward()->size(),1UL);
+        // the forwarding group reads as the current set
+        EXPECT_EQ(group.size(),1UL);
+        EXPECT_FALSE(group.empty());
+        EXPECT_EQ(group[0],&first);
+        EXPECT_EQ(std::vector<Sequence*>(group.begin(),group.end()),std::vector<Sequence*>({&first}));
+        EXPECT_EQ(SequenceGroup(group).size(),1UL);
+
+        // the cached minimum of the previous sequences is not used
+        delete group.Forward(new SequenceGroup(std::vector<Sequence*>({&second})));
+        EXPECT_EQ(group.GetMinimumSequence(6L),8L);
+        delete group.Forward(new SequenceGroup());
+        EXPECT_TRUE(group.empty());
+        EXPECT_EQ(group.GetMinimumSequence(9L),9L);
+        // a sequence added behind what the empty set returned gates again
+        Sequence third(2L);
+        delete group.Forward(new SequenceGroup(std::vector<Sequence*>({&third})));
+        EXPECT_EQ(group.GetMinimumSequence(9L),2L);
+        delete group.GetForward();
+    }
+
+    TEST(SequenceGroupTest,ForwardWhileReading)
+    {
+        std::vector<Sequence> sequences(kSequenceGroupInlineSize * 2);
+        std::vector<Sequence*> pointers;
+        for(size_t i = 0; i < sequences.size(); ++i) {
+            sequences[i].SetSequence(i);
+            pointers.push_back(&sequences[i]);
+        }
+        SequenceGroup group;
+        group.Forward(new SequenceGroup(pointers));
+        std::atomic<bool> running(true);
+        std::vector<std::thread> readers;
+        for(int i = 0; i < 2; ++i) {
+            readers.emplace_back([&](){
+                while(running.load()) {
+                    const int64_t minimum = group.GetMinimumSequence();
+                    EXPECT_LT(minimum,static_cast<int64_t>(sequences.size()));
+                }
+            });
+        }
+        // every previous group is freed as soon as Forward returns
+        for(int n = 0; n < 1000; ++n) {
+            std::vector<Sequence*> replaced(pointers.begin() + n % sequences.size(),pointers.end());
+            delete group.Forward(new SequenceGroup(replaced));
+        }
+        running.store(false);
+        for(auto& reader : readers) {
+            reader.join();
+        }
+        delete group.GetForward();
+    }
+
+    TEST(SequenceGroupTest,NoMinimumOfTheReplacedGroupIsCached)
+    {
+        Sequence ahead(1000L);
+        Sequence behind(5L);
+        SequenceGroup group;
+        group.Forward(new SequenceGroup(std::vector<Sequence*>({&ahead})));
+        std::atomic<bool> running(true);
+        std::vector<std::thread> readers;
+        for(int i = 0; i < 2; ++i) {
+            readers.emplace_back([&](){
+                while(running.load()) {
+                    group.GetMinimumSequence();
+                }
+            });
+        }
+        // a reader which scanned the group ahead before it was replaced
+        // does not leave its minimum in the cache
+        for(int n = 0; n < 1000; ++n) {
+            delete group.Forward(new SequenceGroup(std::vector<Sequence*>({&behind})));
+            EXPECT_EQ(group.GetMinimumSequence(0L),5L);
+            delete group.Forward(new SequenceGroup(std::vector<Sequence*>({&ahead})));
+        }
+        running.store(false);
+        for(auto& reader : readers) {
+            reader.join();
+        }
+        delete group.GetForward();
+    }
+
+} // end namespace test
+} // end namespace disruptor
+
+#endif
\ No newline at end of file
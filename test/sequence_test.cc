@@ -52,6 +52,16 @@ namespace test {
         EXPECT_GE(sizeof(Sequence),CACHE_LINE_SIZE_IN_BYTES);
     }
 
+    TEST(SequenceTest,SequencePaddedOnBothSides)
+    {
+        // the atomic keeps a false sharing range free before and after
+        // it, so neither a neighbour nor an array element shares its line
+        EXPECT_EQ(sizeof(Sequence),2 * FALSE_SHARING_RANGE_IN_BYTES - sizeof(int64_t));
+        Sequence sequences[2];
+        EXPECT_GE(reinterpret_cast<char*>(&sequences[1]) - reinterpret_cast<char*>(&sequences[0]),
+                  2 * FALSE_SHARING_RANGE_IN_BYTES - sizeof(int64_t));
+    }
+
     TEST(SequenceTest,SequenceIsCacheLineAligned)
     {
         // Alignof is used to calculate the alignment requirements 
@@ -193,6 +193,227 @@ TEST_F(SequencerTest,BlockPublisherWhenRingBufferIsFull)
     thread.join();
 }
 
+TEST_F(SequencerTest,TryNextFailsWhenRingBufferIsFull)
+{
+    FillBuffer();
+    const int64_t expected_full_cursor = kInitialCursorValue + RING_BUFFER_SIZE;
+    EXPECT_EQ(sequencer.TryNext(),kInsufficientCapacitySignal);
+    EXPECT_EQ(sequencer.GetCursor(),expected_full_cursor);
+
+    gating_sequence.SetSequence(kFirstSequenceValue);
+    const int64_t sequence = sequencer.TryNext();
+    EXPECT_EQ(sequence,expected_full_cursor + 1L);
+    sequencer.Publish(sequence);
+    EXPECT_EQ(sequencer.GetCursor(),expected_full_cursor + 1L);
+    EXPECT_EQ(sequencer.TryNext(),kInsufficientCapacitySignal);
+}
+
+TEST_F(SequencerTest,AddAndRemoveGatingSequencesWhileFull)
+{
+    FillBuffer();
+    const int64_t expected_full_cursor = kInitialCursorValue + RING_BUFFER_SIZE;
+
+    // a joining consumer starts at the cursor
+    Sequence joined_sequence;
+    sequencer.AddGatingSequences(std::vector<Sequence*>({&joined_sequence}));
+    EXPECT_EQ(joined_sequence.GetSequence(),expected_full_cursor);
+    EXPECT_EQ(sequencer.GetGatingSequenceCount(),2UL);
+    EXPECT_EQ(sequencer.TryNext(),kInsufficientCapacitySignal);
+
+    // the slow consumer leaves, the producers are gated by the joined one
+    EXPECT_EQ(sequencer.RemoveGatingSequences(std::vector<Sequence*>({&gating_sequence})),true);
+    EXPECT_EQ(sequencer.RemoveGatingSequences(std::vector<Sequence*>({&gating_sequence})),false);
+    EXPECT_EQ(sequencer.GetGatingSequenceCount(),1UL);
+    const int64_t sequence = sequencer.TryNext(RING_BUFFER_SIZE);
+    EXPECT_EQ(sequence,expected_full_cursor + RING_BUFFER_SIZE);
+    sequencer.Publish(sequence);
+    EXPECT_EQ(sequencer.TryNext(),kInsufficientCapacitySignal);
+}
+
+TEST(UngatedSequencerTest,AttachFirstConsumerWhileProducing)
+{
+    const ClaimStrategyOption options[] = {kSingleThreadClaimStrategy,
+                                           kMultiThreadClaimStrategy,
+                                           kMultiThreadFetchAddClaimStrategy};
+    for(ClaimStrategyOption option : options) {
+        Sequencer<int64_t> sequencer(8,option,kBusySpinStrategy);
+        // no consumer gates the producers, they claim past a lap
+        for(int i = 0; i < 20; ++i) {
+            sequencer.Publish(sequencer.Next());
+        }
+
+        Sequence consumer;
+        sequencer.AddGatingSequences(std::vector<Sequence*>({&consumer}));
+        EXPECT_EQ(consumer.GetSequence(),sequencer.GetCursor());
+        for(int i = 0; i < 8; ++i) {
+            sequencer.Publish(sequencer.TryNext());
+        }
+        EXPECT_EQ(sequencer.TryNext(),kInsufficientCapacitySignal);
+        EXPECT_EQ(sequencer.HasAvailableCapacity(),false);
+
+        // the same once every consumer left and one is added back
+        EXPECT_EQ(sequencer.RemoveGatingSequences(std::vector<Sequence*>({&consumer})),true);
+        const int64_t high_bound = sequencer.TryNext(8);
+        EXPECT_EQ(high_bound,kInitialCursorValue + 36L);
+        sequencer.Publish(high_bound - 7L,high_bound);
+        sequencer.AddGatingSequences(std::vector<Sequence*>({&consumer}));
+        EXPECT_EQ(consumer.GetSequence(),high_bound);
+        const int64_t refill = sequencer.TryNext(8);
+        EXPECT_EQ(refill,high_bound + 8L);
+        sequencer.Publish(refill - 7L,refill);
+        EXPECT_EQ(sequencer.TryNext(),kInsufficientCapacitySignal);
+        EXPECT_EQ(sequencer.HasAvailableCapacity(),false);
+    }
+}
+
+TEST_F(SequencerTest,ClaimBatchSplitsAtTheWrap)
+{
+    std::vector<Sequence*> dependents;
+    SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+    ClaimedBatch<int64_t> batch = sequencer.Claim(3);
+    EXPECT_EQ(batch.GetLowBound(),kFirstSequenceValue);
+    EXPECT_EQ(batch.size(),3);
+    EXPECT_EQ(batch.GetSpan(0).size,3);
+    EXPECT_EQ(batch.GetSpan(0).data,sequencer[kFirstSequenceValue]);
+    sequencer.Publish(batch);
+    EXPECT_EQ(sequencer.GetCursor(),kFirstSequenceValue + 2L);
+
+    // sequences 3 to 5 use the last slot and the first two
+    gating_sequence.SetSequence(kFirstSequenceValue + 2L);
+    batch = sequencer.Claim(3);
+    EXPECT_EQ(batch.GetSpan(0).size,1);
+    EXPECT_EQ(batch.GetSpan(0).data,sequencer[3]);
+    EXPECT_EQ(batch.GetSpan(1).size,2);
+    EXPECT_EQ(batch.GetSpan(1).data,sequencer[4]);
+    int64_t value = 30;
+    for(int64_t& slot : batch.GetSpan(0)) {
+        slot = value++;
+    }
+    for(int64_t* slot = batch.GetSpan(1).begin(); slot != batch.GetSpan(1).end(); ++slot) {
+        *slot = value++;
+    }
+    EXPECT_EQ(*batch[2],32);
+    sequencer.Publish(batch);
+    EXPECT_EQ(barrier->WaitFor(3),5);
+    EXPECT_EQ(*sequencer[3],30);
+    EXPECT_EQ(*sequencer[5],32);
+}
+
+TEST(SlotLayoutSequencerTest,ClaimBatchOfPaddedAndGroupedSlots)
+{
+    const SlotLayoutOption layouts[] = {kPaddedSlotLayout,kGroupedSlotLayout};
+    for(SlotLayoutOption layout : layouts) {
+        Sequencer<int64_t> sequencer(16,kSingleThreadClaimStrategy,kBusySpinStrategy,
+                                     kWideAvailableBuffer,kYieldingProducerWait,layout);
+        std::vector<Sequence*> dependents;
+        SequenceBarrier* barrier = sequencer.NewBarrier(dependents);
+
+        // a batch of more slots than a span holds
+        ClaimedBatch<int64_t> batch = sequencer.Claim(4);
+        for(int64_t i = 0; i < batch.size(); ++i) {
+            *batch[i] = 10 + i;
+        }
+        sequencer.Publish(batch);
+        EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue),3L);
+        for(int64_t i = 0; i < 4; ++i) {
+            EXPECT_EQ(*sequencer[i],10 + i);
+        }
+
+        // the spans cover the batch slot after slot
+        batch = sequencer.Claim(5);
+        int64_t value = 20;
+        for(int64_t offset = 0; offset < batch.size(); ) {
+            const SlotSpan<int64_t> span = batch.GetSpan(offset);
+            EXPECT_EQ(span.data,sequencer[batch.GetLowBound() + offset]);
+            EXPECT_LE(span.size,layout == kPaddedSlotLayout ? 1 : kDefaultSlotsPerGroup);
+            for(int64_t& slot : span) {
+                slot = value++;
+            }
+            offset += span.size;
+        }
+        sequencer.Publish(batch);
+        for(int64_t i = 4; i < 9; ++i) {
+            EXPECT_EQ(*sequencer[i],16 + i);
+        }
+    }
+}
+
+TEST_F(SequencerTest,TryClaimReturnsAnEmptyBatchWhenFull)
+{
+    FillBuffer();
+    ClaimedBatch<int64_t> batch = sequencer.TryClaim(1);
+    EXPECT_TRUE(batch.empty());
+    gating_sequence.SetSequence(kFirstSequenceValue);
+    batch = sequencer.TryClaim(1);
+    EXPECT_EQ(batch.size(),1);
+    EXPECT_EQ(batch.GetLowBound(),kInitialCursorValue + RING_BUFFER_SIZE + 1L);
+}
+
+TEST(StaticSequencerTest,PublishAndWaitWithStaticPolicies)
+{
+    // strategies are resolved at compile time, options are not needed
+    Sequencer<int64_t,SingleThreadStrategy,BusySpinStrategy> sequencer(RING_BUFFER_SIZE);
+    Sequence gating_sequence;
+    std::vector<Sequence*> sequences;
+    sequences.push_back(&gating_sequence);
+    sequencer.SetGatingSequences(sequences);
+
+    std::vector<Sequence*> dependents;
+    auto barrier = sequencer.NewBarrier(dependents);
+    const int64_t sequence = sequencer.Next(RING_BUFFER_SIZE);
+    EXPECT_EQ(sequence,kInitialCursorValue + RING_BUFFER_SIZE);
+    EXPECT_EQ(sequencer.HasAvailableCapacity(),false);
+
+    sequencer.Publish(sequence);
+    EXPECT_EQ(sequencer.GetCursor(),sequence);
+    EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue),sequence);
+}
+
+TEST(StaticSequencerTest,MultiThreadPolicyPublishOutOfOrder)
+{
+    Sequencer<int64_t,MultiThreadStrategy,YieldingStrategy> sequencer(RING_BUFFER_SIZE);
+    std::vector<Sequence*> dependents;
+    auto barrier = sequencer.NewBarrier(dependents);
+
+    const int64_t first = sequencer.Next();
+    const int64_t second = sequencer.Next();
+    sequencer.Publish(second);
+    EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue,std::chrono::microseconds(1000L)),
+              kInitialCursorValue);
+    sequencer.Publish(first);
+    EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue),second);
+}
+
+TEST(StaticSequencerTest,FixedCapacitySequencer)
+{
+    // the capacity is a template parameter, no buffer size is taken
+    using FixedCapacity = FixedSequencer<int64_t,RING_BUFFER_SIZE,SingleThreadStrategy,BusySpinStrategy>;
+    EXPECT_FALSE((std::is_constructible<FixedCapacity,int64_t>::value));
+    EXPECT_TRUE((std::is_constructible<FixedCapacity,ClaimStrategyOption>::value));
+    FixedCapacity sequencer;
+    EXPECT_EQ(sequencer.GetBufferSize(),RING_BUFFER_SIZE);
+    Sequence gating_sequence;
+    sequencer.SetGatingSequences(std::vector<Sequence*>({&gating_sequence}));
+
+    std::vector<Sequence*> dependents;
+    auto barrier = sequencer.NewBarrier(dependents);
+    for(int64_t i = 0; i < RING_BUFFER_SIZE; ++i) {
+        const int64_t sequence = sequencer.Next();
+        *sequencer[sequence] = sequence * 10;
+        sequencer.Publish(sequence);
+    }
+    EXPECT_EQ(sequencer.HasAvailableCapacity(),false);
+    EXPECT_EQ(barrier->WaitFor(kFirstSequenceValue),kInitialCursorValue + RING_BUFFER_SIZE);
+
+    gating_sequence.SetSequence(kFirstSequenceValue);
+    const int64_t sequence = sequencer.Next();
+    *sequencer[sequence] = -1;
+    sequencer.Publish(sequence);
+    // the slot of the first sequence is reused
+    EXPECT_EQ(*sequencer[kFirstSequenceValue],-1);
+    EXPECT_EQ(*sequencer[kFirstSequenceValue + 1L],10);
+}
+
 } // end namespace test
 } // end namespace disruptor
 
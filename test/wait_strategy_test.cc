@@ -416,6 +416,475 @@ TEST_F(BlockingStrategyTest,WaitForDependentsWithAlert)
     EXPECT_EQ(return_value.load(),kAlertedSignal);
 }
 
+class LiteBlockingStrategyTest : public WaitStrategyTest
+{
+    virtual void SetUp() {
+        strategy = CreateWaitStrategy(kLiteBlockingStrategy);
+    }
+};
+
+TEST_F(LiteBlockingStrategyTest,WaitForCursor)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,dependents,alerted));
+    });
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+    std::thread([this](){
+        cursor.IncrementAndGet(1L);
+        strategy->SignalAllWhenBlocking();
+    }).join();
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kFirstSequenceValue);
+}
+
+TEST_F(LiteBlockingStrategyTest,WaitForTimeout)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        dependents,alerted,std::chrono::microseconds(1L)));
+    });
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kTimeoutSignal);
+    std::thread waiter2([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        dependents,alerted,std::chrono::seconds(1L)));
+    });
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    waiter2.join();
+    EXPECT_EQ(return_value.load(),kFirstSequenceValue);
+}
+
+TEST_F(LiteBlockingStrategyTest,WaitForDependents)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        AllDependents(),alerted));
+    });
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_1.IncrementAndGet(1L);
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_2.IncrementAndGet(1L);
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_3.IncrementAndGet(1L);
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kFirstSequenceValue);
+}
+
+TEST_F(LiteBlockingStrategyTest,WaitForDependentsWithAlert)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        AllDependents(),alerted));
+    });
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_1.IncrementAndGet(1L);
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_2.IncrementAndGet(1L);
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    alerted.store(true);
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kAlertedSignal);
+}
+
+TEST_F(LiteBlockingStrategyTest,WaitForCursorWithAlert)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,dependents,alerted));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(1L));
+    // the barrier signals after setting the alert
+    alerted.store(true);
+    strategy->SignalAllWhenBlocking();
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kAlertedSignal);
+}
+
+class FutexStrategyTest : public WaitStrategyTest
+{
+    virtual void SetUp() {
+        strategy = CreateWaitStrategy(kFutexStrategy);
+    }
+};
+
+TEST_F(FutexStrategyTest,WaitForCursor)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,dependents,alerted));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(1L));
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kFirstSequenceValue);
+}
+
+TEST_F(FutexStrategyTest,WaitForTimeout)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        dependents,alerted,std::chrono::microseconds(100L)));
+    });
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kTimeoutSignal);
+
+    cursor.IncrementAndGet(1L);
+    std::thread waiter2([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        AllDependents(),alerted,std::chrono::microseconds(100L)));
+    });
+    waiter2.join();
+    EXPECT_EQ(return_value.load(),kTimeoutSignal);
+}
+
+TEST_F(FutexStrategyTest,WaitForDependents)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        AllDependents(),alerted));
+    });
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    // upstream processors signal their own sequence when advancing
+    sequence_1.IncrementAndGet(1L);
+    strategy->SignalWhenBlocking(sequence_1);
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_2.IncrementAndGet(1L);
+    strategy->SignalWhenBlocking(sequence_2);
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_3.IncrementAndGet(1L);
+    strategy->SignalWhenBlocking(sequence_3);
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kFirstSequenceValue);
+}
+
+TEST_F(FutexStrategyTest,WaitForDependentsWithAlert)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        AllDependents(),alerted));
+    });
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1L));
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    // as SequenceBarrier::SignalAllWhenBlocking does for an alert
+    alerted.store(true);
+    strategy->SignalAllWhenBlocking();
+    for(Sequence* dependent : AllDependents()) {
+        strategy->SignalWhenBlocking(*dependent);
+    }
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kAlertedSignal);
+}
+
+class PhasedBackoffStrategyTest : public WaitStrategyTest
+{
+    virtual void SetUp() {
+        strategy = CreateWaitStrategy(kPhasedBackoffStrategy);
+    }
+};
+
+TEST_F(PhasedBackoffStrategyTest,WaitForCursor)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,dependents,alerted));
+    });
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+    std::thread([this](){
+        cursor.IncrementAndGet(1L);
+        strategy->SignalAllWhenBlocking();
+    }).join();
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kFirstSequenceValue);
+}
+
+TEST_F(PhasedBackoffStrategyTest,WaitForTimeout)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        dependents,alerted,std::chrono::microseconds(1L)));
+    });
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kTimeoutSignal);
+    std::thread waiter2([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        dependents,alerted,std::chrono::seconds(1L)));
+    });
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    waiter2.join();
+    EXPECT_EQ(return_value.load(),kFirstSequenceValue);
+}
+
+TEST_F(PhasedBackoffStrategyTest,WaitForDependents)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        AllDependents(),alerted));
+    });
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_1.IncrementAndGet(1L);
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_2.IncrementAndGet(1L);
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_3.IncrementAndGet(1L);
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kFirstSequenceValue);
+}
+
+TEST_F(PhasedBackoffStrategyTest,WaitForDependentsWithAlert)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,
+        AllDependents(),alerted));
+    });
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_1.IncrementAndGet(1L);
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    sequence_2.IncrementAndGet(1L);
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+
+    alerted.store(true);
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kAlertedSignal);
+}
+
+TEST_F(PhasedBackoffStrategyTest,WaitForCursorWithAlert)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,dependents,alerted));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(1L));
+    // the barrier signals after setting the alert
+    alerted.store(true);
+    strategy->SignalAllWhenBlocking();
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kAlertedSignal);
+}
+
+TEST_F(PhasedBackoffStrategyTest,CountTimeSpentInEachPhase)
+{
+    PhasedBackoffStrategy phased_strategy(2000L,20000L);
+    EXPECT_EQ(phased_strategy.WaitFor(kFirstSequenceValue,cursor,dependents,alerted,
+              std::chrono::microseconds(100L)),kTimeoutSignal);
+    EXPECT_EQ(phased_strategy.GetCounters().waits,1L);
+    EXPECT_EQ(phased_strategy.GetCounters().timed_out,1L);
+    // a wait finding the sequence available is not counted
+    cursor.IncrementAndGet(1L);
+    EXPECT_EQ(phased_strategy.WaitFor(kFirstSequenceValue,cursor,dependents,alerted),kFirstSequenceValue);
+    EXPECT_EQ(phased_strategy.GetCounters().waits,1L);
+
+    std::thread waiter([&](){
+        EXPECT_EQ(phased_strategy.WaitFor(kFirstSequenceValue + 1L,cursor,dependents,alerted),
+                  kFirstSequenceValue + 1L);
+    });
+    // long enough to go through spinning and yielding
+    std::this_thread::sleep_for(std::chrono::milliseconds(5L));
+    cursor.IncrementAndGet(1L);
+    phased_strategy.SignalAllWhenBlocking();
+    waiter.join();
+
+    const PhasedBackoffCounters counters = phased_strategy.GetCounters();
+    EXPECT_EQ(counters.waits,2L);
+    EXPECT_EQ(counters.timed_out,1L);
+    EXPECT_EQ(counters.alerted,0L);
+    EXPECT_GT(counters.spin_nanos,0L);
+    EXPECT_GT(counters.yield_nanos,0L);
+    EXPECT_GT(counters.block_nanos,0L);
+}
+
+TEST_F(PhasedBackoffStrategyTest,CountAlertedWaits)
+{
+    PhasedBackoffStrategy phased_strategy(2000L,20000L);
+    std::thread waiter([&](){
+        EXPECT_EQ(phased_strategy.WaitFor(kFirstSequenceValue,cursor,dependents,alerted),kAlertedSignal);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5L));
+    alerted.store(true);
+    phased_strategy.SignalAllWhenBlocking();
+    waiter.join();
+
+    const PhasedBackoffCounters counters = phased_strategy.GetCounters();
+    EXPECT_EQ(counters.waits,1L);
+    EXPECT_EQ(counters.alerted,1L);
+    EXPECT_GT(counters.block_nanos,0L);
+}
+
+TEST_F(PhasedBackoffStrategyTest,KeepAnAverageWaitPerBarrier)
+{
+    const int64_t max_spin_nanos = 200000L;
+    PhasedBackoffStrategy phased_strategy(max_spin_nanos,max_spin_nanos);
+    // long waits on a first barrier: its spin phase drops to the minimum
+    WaitState first_state;
+    for(int i = 0; i < 40; ++i) {
+        EXPECT_EQ(phased_strategy.BarrierWaitFor(kFirstSequenceValue,cursor,dependents,alerted,
+                  std::chrono::microseconds(2000L),first_state),kTimeoutSignal);
+    }
+    EXPECT_GT(first_state.average_wait_nanos,max_spin_nanos);
+    // a second barrier starts from its own average, half the maximum
+    // spin, and spins twice as long
+    WaitState second_state;
+    const int64_t spin_nanos = phased_strategy.GetCounters().spin_nanos;
+    EXPECT_EQ(phased_strategy.BarrierWaitFor(kFirstSequenceValue,cursor,dependents,alerted,
+              std::chrono::microseconds(1000L),second_state),kTimeoutSignal);
+    EXPECT_GE(phased_strategy.GetCounters().spin_nanos - spin_nanos,max_spin_nanos / 2);
+}
+
+#if defined(__linux__)
+class EventFdStrategyTest : public WaitStrategyTest
+{
+    virtual void SetUp() {
+        strategy = &eventfd_strategy;
+    }
+public:
+    EventFdStrategy eventfd_strategy;
+
+    bool Readable(int timeout_millis) {
+        return Readable(eventfd_strategy.GetFileDescriptor(),timeout_millis);
+    }
+
+    bool Readable(int fd,int timeout_millis) {
+        struct pollfd poll_fd;
+        poll_fd.fd = fd;
+        poll_fd.events = POLLIN;
+        return poll(&poll_fd,1,timeout_millis) == 1;
+    }
+};
+
+TEST_F(EventFdStrategyTest,WaitForCursor)
+{
+    std::atomic<int64_t> return_value(kInitialCursorValue);
+    std::thread waiter([this,&return_value](){
+        return_value.store(strategy->WaitFor(kFirstSequenceValue,cursor,dependents,alerted));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(1L));
+    EXPECT_EQ(return_value.load(),kInitialCursorValue);
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    waiter.join();
+    EXPECT_EQ(return_value.load(),kFirstSequenceValue);
+}
+
+TEST_F(EventFdStrategyTest,WaitForTimeout)
+{
+    EXPECT_EQ(strategy->WaitFor(kFirstSequenceValue,cursor,dependents,alerted,
+              std::chrono::microseconds(100L)),kTimeoutSignal);
+}
+
+TEST_F(EventFdStrategyTest,CoalesceSignalsUntilAcknowledged)
+{
+    ASSERT_GE(eventfd_strategy.GetFileDescriptor(),0);
+    EXPECT_EQ(Readable(0),false);
+
+    // a burst writes the eventfd once
+    for(int i = 0; i < 3; ++i) {
+        cursor.IncrementAndGet(1L);
+        strategy->SignalAllWhenBlocking();
+    }
+    EXPECT_EQ(Readable(0),true);
+    uint64_t value = 0;
+    EXPECT_EQ(read(eventfd_strategy.GetFileDescriptor(),&value,sizeof(value)),
+              static_cast<ssize_t>(sizeof(value)));
+    EXPECT_EQ(value,1UL);
+
+    // not signalled again before the consumer acknowledges
+    strategy->SignalAllWhenBlocking();
+    EXPECT_EQ(Readable(0),false);
+
+    eventfd_strategy.Acknowledge();
+    strategy->SignalAllWhenBlocking();
+    EXPECT_EQ(Readable(0),true);
+    eventfd_strategy.Acknowledge();
+    EXPECT_EQ(Readable(0),false);
+}
+
+TEST_F(EventFdStrategyTest,WakeEveryWaiterOnOnePublish)
+{
+    std::atomic<int64_t> returned(0);
+    std::vector<std::thread> waiters;
+    for(int i = 0; i < 2; ++i) {
+        waiters.emplace_back([this,&returned](){
+            if(strategy->WaitFor(kFirstSequenceValue,cursor,dependents,alerted) == kFirstSequenceValue) {
+                returned.fetch_add(1);
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1L));
+    EXPECT_EQ(returned.load(),0L);
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    for(auto& waiter : waiters) {
+        waiter.join();
+    }
+    EXPECT_EQ(returned.load(),2L);
+}
+
+TEST_F(EventFdStrategyTest,EachConsumerAcknowledgesItsOwnEventFd)
+{
+    EventFdSignal* second = eventfd_strategy.AddConsumer();
+    ASSERT_NE(second,nullptr);
+    ASSERT_GE(second->GetFileDescriptor(),0);
+    EXPECT_NE(second->GetFileDescriptor(),eventfd_strategy.GetFileDescriptor());
+
+    cursor.IncrementAndGet(1L);
+    strategy->SignalAllWhenBlocking();
+    EXPECT_EQ(Readable(0),true);
+    EXPECT_EQ(Readable(second->GetFileDescriptor(),0),true);
+
+    // the first consumer acknowledging does not take the second's signal
+    eventfd_strategy.Acknowledge();
+    EXPECT_EQ(Readable(0),false);
+    EXPECT_EQ(Readable(second->GetFileDescriptor(),0),true);
+    second->Acknowledge();
+    EXPECT_EQ(Readable(second->GetFileDescriptor(),0),false);
+
+    for(size_t i = 2; i < kMaxEventFdConsumers; ++i) {
+        EXPECT_NE(eventfd_strategy.AddConsumer(),nullptr);
+    }
+    EXPECT_EQ(eventfd_strategy.AddConsumer(),nullptr);
+}
+#endif
+
 } // end namespace test
 } // end namespace disruptor
 